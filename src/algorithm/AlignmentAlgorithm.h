@@ -4,6 +4,8 @@
 
 #include <NTSequence.h>
 #include <AASequence.h>
+#include <ScoringMatrix.h>
+#include <AlignmentTranscript.h>
 
 /**
  * libseq namespace
@@ -28,9 +30,81 @@ class AlignmentAlgorithm {
      */
     virtual double align(AASequence& seq1, AASequence& seq2) = 0;
 
+    /**
+     * Pair-wise align two nucleotide sequences, without modifying them.
+     *
+     * The result is the transcript of a global alignment of the two
+     * sequences (with gaps removed). The default implementation uses
+     * align(NTSequence&, NTSequence&) on copies of the sequences.
+     */
+    virtual AlignmentTranscript computeAlignment(const NTSequence& seq1,
+						 const NTSequence& seq2);
+
+    /**
+     * Pair-wise align two amino acid sequences, without modifying them.
+     *
+     * The result is the transcript of a global alignment of the two
+     * sequences (with gaps removed). The default implementation uses
+     * align(AASequence&, AASequence&) on copies of the sequences.
+     */
+    virtual AlignmentTranscript computeAlignment(const AASequence& seq1,
+						 const AASequence& seq2);
+
+    /**
+     * Compute the score of an optimal global alignment of two
+     * nucleotide sequences, without computing the alignment itself.
+     *
+     * The default implementation uses computeAlignment().
+     * Implementations may compute the score using less memory.
+     */
+    virtual double computeOptimalScore(const NTSequence& seq1,
+				       const NTSequence& seq2);
+
+    /**
+     * Compute the score of an optimal global alignment of two amino
+     * acid sequences, without computing the alignment itself.
+     *
+     * The default implementation uses computeAlignment().
+     * Implementations may compute the score using less memory.
+     */
+    virtual double computeOptimalScore(const AASequence& seq1,
+				       const AASequence& seq2);
+
+    /**
+     * Compute the score of an optimal global alignment of two views on
+     * nucleotide sequences, such as regions of larger sequences.
+     *
+     * The default implementation uses computeOptimalScore() on copies
+     * of the views. Implementations may compute the score without
+     * copying.
+     */
+    virtual double computeOptimalScore(const NTSequenceView& seq1,
+				       const NTSequenceView& seq2);
+
+    /**
+     * Compute the score of an optimal global alignment of two views on
+     * amino acid sequences.
+     *
+     * The default implementation uses computeOptimalScore() on copies
+     * of the views.
+     */
+    virtual double computeOptimalScore(const AASequenceView& seq1,
+				       const AASequenceView& seq2);
+
     virtual double computeAlignScore(const NTSequence& seq1, 
 				     const NTSequence& seq2) = 0;
 
+    /**
+     * Get a hash of the algorithm and its parameters.
+     *
+     * Two algorithms with the same parameter hash must compute the
+     * same alignments. It is used to identify cached alignments (see
+     * AlignmentCache). The default implementation hashes the type of
+     * the algorithm: implementations with parameters (such as gap
+     * scores) must include these.
+     */
+    virtual boost::uint64_t parameterHash() const;
+
     /**
      * Similarity weights matrix for nucleotides.
      *
@@ -49,6 +123,16 @@ class AlignmentAlgorithm {
      * From: ftp://ftp.ncbi.nih.gov/blast/matrices/BLOSUM30
      */
     static double** BLOSUM30();
+
+    /**
+     * The IUB() matrix, as a scoring matrix.
+     */
+    static const NTScoringMatrix& IUBScores();
+
+    /**
+     * The BLOSUM30() matrix, as a scoring matrix.
+     */
+    static const AAScoringMatrix& BLOSUM30Scores();
   };
 
 }
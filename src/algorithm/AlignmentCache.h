@@ -0,0 +1,169 @@
+// This may look like C code, but it's really -*- C++ -*-
+#ifndef ALIGNMENT_CACHE_H_
+#define ALIGNMENT_CACHE_H_
+
+#include <string>
+#include <vector>
+#include <boost/cstdint.hpp>
+
+#include <CodonAlign.h>
+
+/**
+ * libseq namespace
+ */
+namespace seq {
+
+/**
+ * A cache of codon alignment results.
+ *
+ * Results are identified by a 128-bit hash of the content of the
+ * reference and target sequences (ignoring gaps, names and
+ * descriptions), the maximum number of frame shifts, and the
+ * AlignmentAlgorithm::parameterHash() of the algorithm. The outcome
+ * of CodonAlign::align() is stored compactly (the aligned sequences
+ * packed as PackedNTSequence), including a failure, which is rethrown
+ * by align(), or reported by tryAlign(), when the result is found in
+ * the cache.
+ *
+ * The cache has two layers:
+ *  - an in-memory layer with a least recently used replacement
+ *    policy, with a limited size. It is divided in shards with their
+ *    own lock, so that worker threads can use the cache concurrently.
+ *  - an optional persistent layer, which is a file to which all
+ *    results are appended (see open()). Its index is kept in memory.
+ *
+ * When two threads align the same sequences at the same time, both
+ * compute the alignment.
+ */
+class AlignmentCache
+{
+public:
+  /**
+   * The key of a cached result.
+   */
+  struct Key {
+    boost::uint64_t hash1, hash2;
+
+    bool operator== (const Key& other) const {
+      return hash1 == other.hash1 && hash2 == other.hash2;
+    }
+  };
+
+  /**
+   * Create a cache.
+   *
+   * The in-memory layer holds up to (approximately) memorySize bytes,
+   * in shardCount shards.
+   */
+  AlignmentCache(std::size_t memorySize = 64 << 20, unsigned shardCount = 16);
+
+  /**
+   * Destructor.
+   */
+  ~AlignmentCache();
+
+  /**
+   * Open a file as persistent layer.
+   *
+   * Results in an existing file are available, and new results are
+   * appended to it. The file is created if it does not exist. Throws
+   * a std::runtime_error if the file cannot be opened, or is not an
+   * alignment cache file.
+   */
+  void open(const std::string& fileName);
+
+  /**
+   * Perform a codon-based alignment, using the cache.
+   *
+   * The result, and the effect on ref and target, are identical to
+   * aligner.align(ref, target, maxFrameShifts). The names and
+   * descriptions of ref and target are preserved.
+   *
+   * @throws AlignmentError or FrameShiftError like CodonAlign::align().
+   */
+  std::pair<double, int> align(CodonAlign& aligner,
+			       NTSequence& ref, NTSequence& target,
+			       int maxFrameShifts = 1);
+
+  /**
+   * Perform a codon-based alignment, using the cache, reporting
+   * failure in result instead of throwing an exception.
+   *
+   * The result, and the effect on ref and target, are identical to
+   * aligner.tryAlign(ref, target, maxFrameShifts, result).
+   */
+  CodonAlign::Outcome tryAlign(CodonAlign& aligner,
+			       NTSequence& ref, NTSequence& target,
+			       int maxFrameShifts,
+			       CodonAlign::Result& result);
+
+  /**
+   * Compute the key of an alignment.
+   */
+  static Key key(const AlignmentAlgorithm& algorithm,
+		 const NTSequence& ref, const NTSequence& target,
+		 int maxFrameShifts);
+
+  /**
+   * Compute the key of an alignment by a codon aligner: like
+   * key(const AlignmentAlgorithm&, ...), but also including the
+   * parameters of its prefilter (if any).
+   */
+  static Key key(const CodonAlign& aligner,
+		 const NTSequence& ref, const NTSequence& target,
+		 int maxFrameShifts);
+
+  /**
+   * Get the number of results found in memory.
+   */
+  unsigned long long hitCount() const;
+
+  /**
+   * Get the number of results found in the persistent layer.
+   */
+  unsigned long long persistentHitCount() const;
+
+  /**
+   * Get the number of results that were computed.
+   */
+  unsigned long long missCount() const;
+
+  /**
+   * Get the number of results in memory.
+   */
+  unsigned entryCount() const;
+
+  /**
+   * Get the approximate number of bytes used by the results in memory.
+   */
+  std::size_t memoryUsage() const;
+
+  /**
+   * Remove all results from memory (the persistent layer is not
+   * affected).
+   */
+  void clear();
+
+  /// \cond
+  struct Outcome;
+  class Shard;
+  class Store;
+  /// \endcond
+
+private:
+  std::vector<Shard *> shards_;
+  Store *store_;
+
+  Shard& shard(const Key& key) const;
+
+  static Key key(boost::uint64_t parameterHash,
+		 const NTSequence& ref, const NTSequence& target,
+		 int maxFrameShifts);
+
+  AlignmentCache(const AlignmentCache&);
+  AlignmentCache& operator=(const AlignmentCache&);
+};
+
+};
+
+#endif // ALIGNMENT_CACHE_H_
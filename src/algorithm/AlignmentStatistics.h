@@ -0,0 +1,153 @@
+// This may look like C code, but it's really -*- C++ -*-
+#ifndef ALIGNMENT_STATISTICS_H_
+#define ALIGNMENT_STATISTICS_H_
+
+#include <iostream>
+#include <boost/chrono.hpp>
+
+/**
+ * libseq namespace
+ */
+namespace seq {
+
+/**
+ * Statistics on the work done by CodonAlign (and the underlying
+ * AlignmentAlgorithm).
+ *
+ * Statistics are only recorded when the library is compiled with
+ * SEQ_INSTRUMENTATION defined (cmake -DSEQ_INSTRUMENTATION=ON);
+ * otherwise the instrumentation compiles to nothing and all counters
+ * remain zero.
+ *
+ * Every thread records into its own counters, which are aggregated by
+ * total() and dump(). Counters of threads that have finished are kept.
+ */
+class AlignmentStatistics
+{
+public:
+  /**
+   * The stages of CodonAlign::align().
+   */
+  enum Stage {
+    NucleotideAlignment,   //!< direct nucleotide alignment
+    AminoAcidAlignment,    //!< translation and alignment of the 3 ORFs
+    CodonLayout,           //!< laying out the codon alignment
+    FrameShiftCorrection,  //!< search for a frameshift to correct
+    StrandDetection,       //!< score-only alignment of the 6 frames
+    Prefilter,             //!< HomologyPrefilter test
+    Other,                 //!< work outside CodonAlign::align()
+    StageCount
+  };
+
+  /**
+   * The outcome of CodonAlign::align().
+   */
+  enum Outcome {
+    Success,               //!< aligned
+    AlignmentRejected,     //!< AlignmentError: nucleotide score too low
+    FrameShiftRejected,    //!< FrameShiftError
+    PrefilterRejected,     //!< AlignmentError: rejected by the prefilter
+    OutcomeCount
+  };
+
+  /**
+   * A set of counters.
+   */
+  struct Counters {
+    unsigned long long calls[StageCount];   //!< times a stage was run
+    double             seconds[StageCount]; //!< wall time per stage
+    unsigned long long cells[StageCount];   //!< dynamic programming cells
+    unsigned long long bytes[StageCount];   //!< bytes allocated
+    unsigned long long outcomes[OutcomeCount];
+    unsigned long long frameShiftRetries;   //!< corrected frameshifts
+
+    Counters();
+
+    /**
+     * Add the counts of other to these counters.
+     */
+    void add(const Counters& other);
+  };
+
+  /**
+   * Whether the library was compiled with instrumentation.
+   */
+  static bool enabled();
+
+  /**
+   * Get the counters aggregated over all threads.
+   */
+  static Counters total();
+
+  /**
+   * Get the counters of the calling thread.
+   */
+  static Counters thread();
+
+  /**
+   * Reset the counters of all threads.
+   */
+  static void reset();
+
+  /**
+   * Write a summary of the aggregated counters.
+   */
+  static void dump(std::ostream& o);
+
+  /**
+   * Write a summary of the given counters.
+   *
+   * The formatting of o (flags and precision) is restored afterwards.
+   */
+  static void dump(std::ostream& o, const Counters& counters);
+
+  /**
+   * @name Recording
+   *
+   * These are used by the instrumentation macros.
+   */
+  //@{
+  /**
+   * Records the wall time of a stage, for the lifetime of the object.
+   * Work reported with addWork() meanwhile is attributed to the stage.
+   */
+  class ScopedStage {
+  public:
+    ScopedStage(Stage stage);
+    ~ScopedStage();
+
+  private:
+    Stage stage_, previous_;
+    boost::chrono::steady_clock::time_point start_;
+  };
+
+  static void addWork(unsigned long long cells, unsigned long long bytes);
+  static void addOutcome(Outcome outcome);
+  static void addFrameShiftRetry();
+  //@}
+
+  /// \cond
+  struct ThreadCounters;
+  /// \endcond
+};
+
+};
+
+#ifdef SEQ_INSTRUMENTATION
+#define SEQ_STAT_STAGE(stage)						\
+  seq::AlignmentStatistics::ScopedStage					\
+    seqStatStage_(seq::AlignmentStatistics::stage)
+#define SEQ_STAT_WORK(cells, bytes)					\
+  seq::AlignmentStatistics::addWork(cells, bytes)
+#define SEQ_STAT_OUTCOME(outcome)					\
+  seq::AlignmentStatistics::addOutcome(seq::AlignmentStatistics::outcome)
+#define SEQ_STAT_FRAMESHIFT_RETRY()					\
+  seq::AlignmentStatistics::addFrameShiftRetry()
+#else
+#define SEQ_STAT_STAGE(stage)
+#define SEQ_STAT_WORK(cells, bytes)
+#define SEQ_STAT_OUTCOME(outcome)
+#define SEQ_STAT_FRAMESHIFT_RETRY()
+#endif
+
+#endif // ALIGNMENT_STATISTICS_H_
@@ -0,0 +1,227 @@
+// This may look like C code, but it's really -*- C++ -*-
+#ifndef ALIGNMENT_TRANSCRIPT_H_
+#define ALIGNMENT_TRANSCRIPT_H_
+
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <ParseException.h>
+
+/**
+ * libseq namespace
+ */
+namespace seq {
+
+/**
+ * The result of a pair-wise alignment, as an edit transcript.
+ *
+ * The transcript describes how the residues of two (ungapped)
+ * sequences are aligned, as a series of runs of operations, similar
+ * to a CIGAR string:
+ *  - Match ('M'): residues of both sequences are aligned
+ *  - Insertion ('I'): a residue of the second sequence is aligned
+ *    against a gap in the first sequence
+ *  - Deletion ('D'): a residue of the first sequence is aligned
+ *    against a gap in the second sequence
+ *  - SoftClip ('S'): a residue of the second sequence is not part of
+ *    the alignment
+ *
+ * The aligned sequences are only materialized on request, using
+ * render().
+ *
+ * \sa AlignmentAlgorithm::computeAlignment()
+ */
+class AlignmentTranscript
+{
+public:
+  /**
+   * An alignment operation.
+   */
+  enum Operation {
+    Match = 'M',
+    Insertion = 'I',
+    Deletion = 'D',
+    SoftClip = 'S'
+  };
+
+  /**
+   * A run of identical operations.
+   */
+  struct Run {
+    Operation operation;
+    unsigned  length;
+
+    Run(Operation anOperation, unsigned aLength)
+      : operation(anOperation), length(aLength) { }
+  };
+
+  /**
+   * Create an empty transcript, with score 0.
+   */
+  AlignmentTranscript();
+
+  /**
+   * Parse a transcript from its CIGAR representation.
+   *
+   * \sa cigar()
+   */
+  AlignmentTranscript(const std::string& cigar, double score)
+    throw (ParseException);
+
+  /**
+   * Append operations at the end.
+   */
+  void add(Operation operation, unsigned length = 1);
+
+  /**
+   * Reverse the order of the operations.
+   */
+  void reverse();
+
+  /**
+   * Get the runs of operations.
+   */
+  const std::vector<Run>& runs() const { return runs_; }
+
+  /**
+   * Get the alignment score.
+   */
+  double score() const { return score_; }
+
+  /**
+   * Set the alignment score.
+   */
+  void setScore(double score) { score_ = score; }
+
+  /**
+   * Get the number of residues of the first sequence.
+   */
+  unsigned length1() const;
+
+  /**
+   * Get the number of residues of the second sequence.
+   */
+  unsigned length2() const;
+
+  /**
+   * Get the length of the aligned sequences.
+   */
+  unsigned alignedLength() const;
+
+  /**
+   * Get the CIGAR representation, e.g. "3S10M3I5M".
+   */
+  std::string cigar() const;
+
+  /**
+   * Create the aligned sequences.
+   *
+   * The sequences seq1 and seq2 are the ungapped sequences that were
+   * aligned. Symbols is a vector of Nucleotide or AminoAcid. The
+   * aligned sequences are written to aligned1 and aligned2, in time
+   * linear in the alignment length.
+   */
+  template <class Symbols>
+  void render(const Symbols& seq1, const Symbols& seq2,
+	      Symbols& aligned1, Symbols& aligned2) const;
+
+  /**
+   * Get the transcript of two aligned sequences, of equal length.
+   *
+   * Columns with a gap in both sequences are ignored.
+   */
+  template <class Symbols>
+  static AlignmentTranscript fromAlignment(const Symbols& aligned1,
+					   const Symbols& aligned2,
+					   double score);
+
+private:
+  std::vector<Run> runs_;
+  double score_;
+};
+
+/**
+ * Write the CIGAR representation and the score.
+ */
+extern std::ostream& operator<< (std::ostream& o,
+				 const AlignmentTranscript& transcript);
+
+template <class Symbols>
+void AlignmentTranscript::render(const Symbols& seq1, const Symbols& seq2,
+				 Symbols& aligned1, Symbols& aligned2) const
+{
+  typedef typename Symbols::value_type Symbol;
+
+  if (seq1.size() != length1() || seq2.size() != length2())
+    throw std::runtime_error("AlignmentTranscript::render(): sequence "
+			     "lengths do not match the transcript");
+
+  const unsigned length = alignedLength();
+  aligned1.clear();
+  aligned1.reserve(length);
+  aligned2.clear();
+  aligned2.reserve(length);
+
+  typename Symbols::const_iterator i1 = seq1.begin(), i2 = seq2.begin();
+
+  for (unsigned i = 0; i < runs_.size(); ++i) {
+    const unsigned n = runs_[i].length;
+
+    switch (runs_[i].operation) {
+    case Match:
+      aligned1.insert(aligned1.end(), i1, i1 + n);
+      aligned2.insert(aligned2.end(), i2, i2 + n);
+      i1 += n;
+      i2 += n;
+      break;
+    case Insertion:
+      aligned1.insert(aligned1.end(), n, Symbol::GAP);
+      aligned2.insert(aligned2.end(), i2, i2 + n);
+      i2 += n;
+      break;
+    case Deletion:
+      aligned1.insert(aligned1.end(), i1, i1 + n);
+      aligned2.insert(aligned2.end(), n, Symbol::GAP);
+      i1 += n;
+      break;
+    case SoftClip:
+      i2 += n;
+    }
+  }
+}
+
+template <class Symbols>
+AlignmentTranscript
+AlignmentTranscript::fromAlignment(const Symbols& aligned1,
+				   const Symbols& aligned2,
+				   double score)
+{
+  typedef typename Symbols::value_type Symbol;
+
+  if (aligned1.size() != aligned2.size())
+    throw std::runtime_error("AlignmentTranscript::fromAlignment(): "
+			     "aligned sequences have different lengths");
+
+  AlignmentTranscript result;
+  result.setScore(score);
+
+  for (unsigned i = 0; i < aligned1.size(); ++i) {
+    const bool gap1 = aligned1[i] == Symbol::GAP;
+    const bool gap2 = aligned2[i] == Symbol::GAP;
+
+    if (!gap1 && !gap2)
+      result.add(Match);
+    else if (gap1 && !gap2)
+      result.add(Insertion);
+    else if (!gap1 && gap2)
+      result.add(Deletion);
+  }
+
+  return result;
+}
+
+};
+
+#endif // ALIGNMENT_TRANSCRIPT_H_
@@ -0,0 +1,35 @@
+// This may look like C code, but it's really -*- C++ -*-
+#ifndef ALPHABET_H_
+#define ALPHABET_H_
+
+#include <Nucleotide.h>
+#include <AminoAcid.h>
+
+/**
+ * libseq namespace
+ */
+namespace seq {
+
+/**
+ * Properties of the alphabet of a symbol type (Nucleotide or
+ * AminoAcid), for storing a value per symbol in flat arrays.
+ */
+template <class Symbol> struct Alphabet;
+
+/// \cond
+template <> struct Alphabet<Nucleotide> {
+  static const int SIZE = Nucleotide::NT_GAP + 1;
+  static const int STRIDE = 16;
+  static const int ANY = Nucleotide::NT_N;
+};
+
+template <> struct Alphabet<AminoAcid> {
+  static const int SIZE = AminoAcid::AA_J + 1;
+  static const int STRIDE = 32;
+  static const int ANY = AminoAcid::AA_X;
+};
+/// \endcond
+
+};
+
+#endif // ALPHABET_H_
@@ -3,6 +3,7 @@
 #define CODON_ALIGN_H_
 
 #include <AlignmentAlgorithm.h>
+#include <HomologyPrefilter.h>
 
 /**
  * libseq namespace
@@ -63,11 +64,86 @@ public:
 
 class CodonAlign {
 public:
+  /**
+   * The outcome of a codon-based alignment.
+   */
+  enum Outcome {
+    Success,            //!< the sequences are aligned
+    AlignmentRejected,  //!< the nucleotide alignment score is below 200
+    FrameShiftRejected, //!< frameshifts could not be corrected
+    PrefilterRejected   //!< the target is rejected by the prefilter
+  };
+
+  /**
+   * The result of a codon-based alignment by tryAlign().
+   *
+   * A result may be reused for many alignments, in which case the
+   * memory of the aligned sequences is reused as well.
+   */
+  struct Result {
+    Outcome    outcome;
+    double     ntScore;     //!< nucleotide alignment score (or prediction)
+    double     codonScore;  //!< score of the codon alignment (if computed)
+    int        frameShifts; //!< number of corrected frameshifts
+
+    /**
+     * When the alignment failed: the nucleotide aligned sequences
+     * (or, for PrefilterRejected, the unaligned sequences), like
+     * AlignmentError::nucleotideAlignedRef() and
+     * AlignmentError::nucleotideAlignedTarget(). Empty on success.
+     */
+    NTSequence ntRef, ntTarget;
+
+    Result();
+
+    /**
+     * Return whether the alignment succeeded.
+     */
+    bool success() const { return outcome == Success; }
+
+    /**
+     * Clear ntRef and ntTarget (including their names), keeping their
+     * memory.
+     */
+    void clearSequences();
+
+    /**
+     * Get the message of the AlignmentError that align() throws for
+     * this outcome (empty on success).
+     */
+    std::string message() const;
+  };
+
   /**
    * Constructor
    */
   CodonAlign(AlignmentAlgorithm* algorithm);
 
+  /**
+   * Get the algorithm used for the pair-wise alignments.
+   */
+  AlignmentAlgorithm *algorithm() const { return algorithm_; }
+
+  /**
+   * Set a prefilter that rejects unrelated targets before they are
+   * aligned (0 to disable, which is the default).
+   *
+   * The prefilter is only used by align() for the reference for which
+   * it was created: a target that it rejects results in an
+   * AlignmentError, with the predicted score as nucleotide alignment
+   * score and the unaligned sequences. The prefilter is not owned.
+   */
+  void setPrefilter(const HomologyPrefilter *prefilter) {
+    prefilter_ = prefilter;
+  }
+
+  /**
+   * Get the prefilter.
+   *
+   * \sa setPrefilter()
+   */
+  const HomologyPrefilter *prefilter() const { return prefilter_; }
+
  /**
  * Perform codon-based alignment of nucleotide sequences.
  *
@@ -92,20 +168,108 @@ public:
  * The result is the nucleotide alignment score of the codon alignment, and
  * the number of frameshifts that have been corrected.
  *
+ * Gaps in ref and target are ignored (with a warning). On failure, ref
+ * is unchanged, and so is target unless a frameshift was corrected: it
+ * then holds the corrected target, without gaps.
+ *
+ * @throws AlignmentError when the nucleotide alignment score is below
+ *         200, or the target is rejected by the prefilter (see
+ *         setPrefilter()).
  * @throws FrameShiftError when frameshifts could not be corrected, or
  *         the number of detected frameshifts exceeds maxFrameShifts.
  */
  std::pair<double, int>
  align(NTSequence& ref, NTSequence& target, int maxFrameShifts = 1);
 
+  /**
+   * The orientation of a target sequence with respect to the
+   * reference.
+   */
+  enum Strand {
+    Forward,          //!< the target is in the orientation of the reference
+    ReverseComplement //!< the target is reverse complemented
+  };
+
+  /**
+   * Detect the orientation of a target sequence.
+   *
+   * The translated reference is aligned against the target translated
+   * in all six frames (three on each strand), computing only the
+   * alignment scores (using AlignmentAlgorithm::computeOptimalScore()).
+   * The strand with the best scoring frame is returned.
+   */
+  Strand detectStrand(const NTSequence& ref, const NTSequence& target);
+
+  /**
+   * Perform codon-based alignment of a target sequence that may be
+   * in either orientation.
+   *
+   * The orientation is determined using detectStrand(). If the target
+   * is reverse complemented, it is reverse complemented in place,
+   * after which it is aligned like with align(ref, target,
+   * maxFrameShifts). The detected orientation is returned in strand.
+   */
+  std::pair<double, int>
+  align(NTSequence& ref, NTSequence& target, int maxFrameShifts,
+	Strand& strand);
+
+  /**
+   * Perform a codon-based alignment like align(), but report failure
+   * in result instead of throwing an exception.
+   *
+   * On success, ref and target are aligned in place, like with
+   * align(). On failure, ref and target are left like align() leaves
+   * them when it throws (unchanged, unless a frameshift was corrected
+   * in target), and the nucleotide aligned sequences (which align()
+   * copies into the exception) are rendered directly into result.
+   * This avoids the cost of exceptions in batches where failures are
+   * routine.
+   *
+   * Returns result.outcome.
+   */
+  Outcome tryAlign(NTSequence& ref, NTSequence& target, int maxFrameShifts,
+		   Result& result);
+
+  /**
+   * Perform a codon-based alignment of a target sequence that may be
+   * in either orientation, like align(ref, target, maxFrameShifts,
+   * strand), but report failure in result.
+   *
+   * \sa tryAlign(NTSequence&, NTSequence&, int, Result&)
+   */
+  Outcome tryAlign(NTSequence& ref, NTSequence& target, int maxFrameShifts,
+		   Strand& strand, Result& result);
+
+  /**
+   * Get the message of the AlignmentError that align() throws for an
+   * outcome (empty for Success).
+   */
+  static std::string message(Outcome outcome);
+
+  /**
+   * Throw the AlignmentError or FrameShiftError that align() throws
+   * for a failed result. Does nothing if the result is a success.
+   */
+  static void throwIfFailed(const Result& result);
+
 private:
+  Outcome alignCodons(NTSequence& ref, NTSequence& target,
+		      int maxFrameShifts, Result& result);
+  static bool hasGaps(const NTSequence& seq);
   bool haveGaps(const NTSequence& seq, int from, int to);
-  double alignLikeAA(NTSequence& seq1, NTSequence& seq2, 
-		     int ORF, 
-		     const AASequence& seqAA1, const AASequence& seqAA2);
-  bool noGapAt(const NTSequence& seq, unsigned int i) const;
+  double bestFrameScore(const AASequence& refAA, const NTSequence& target);
+  AlignmentTranscript alignLikeAA(const AlignmentTranscript& aaAlignment,
+				  int ORF, unsigned refLength,
+				  unsigned targetLength);
+  void render(const AlignmentTranscript& alignment,
+	      const NTSequence& ref, const NTSequence& target,
+	      NTSequence& alignedRef, NTSequence& alignedTarget);
+  bool fixFrameShift(const NTSequence& refNTAligned,
+		     const NTSequence& targetNTAligned,
+		     NTSequence& target);
 
   AlignmentAlgorithm* algorithm_;
+  const HomologyPrefilter *prefilter_;
 };
 }
 
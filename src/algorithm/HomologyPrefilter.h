@@ -0,0 +1,138 @@
+// This may look like C code, but it's really -*- C++ -*-
+#ifndef HOMOLOGY_PREFILTER_H_
+#define HOMOLOGY_PREFILTER_H_
+
+#include <vector>
+#include <boost/cstdint.hpp>
+
+#include "NTSequence.h"
+
+namespace seq {
+
+/**
+ * A fast test whether a target sequence is homologous to a reference
+ * sequence, to reject unrelated targets before a full alignment.
+ *
+ * The test has two stages. First, the k-mers of the target are looked
+ * up in a bit map of the k-mers of the reference: a target with too
+ * few shared k-mers is rejected. Otherwise, the edit distance between
+ * the target and its best matching part of the reference (free end
+ * gaps in the reference) is computed using Myers' bit-parallel
+ * algorithm, which processes 64 target nucleotides per machine word.
+ * From the edit distance e and the target length m, the nucleotide
+ * alignment score is predicted as (m - e) * matchScore + e * editScore,
+ * and the target is rejected if the prediction is below the minimum
+ * score.
+ *
+ * The k-mer stage takes microseconds, the edit distance stage time
+ * proportional to the product of the sequence lengths divided by 64,
+ * compared with the full product for an alignment.
+ *
+ * The default match score (5) is that of the IUB matrix, and the
+ * default minimum score (200) the nucleotide score below which
+ * CodonAlign::align() throws an AlignmentError. The default edit
+ * score (-6) lies between the IUB mismatch score and the cost of a
+ * gap, and makes the prediction for unrelated sequences (which, with
+ * unit edit costs, align with an identity of 52% - 57%) close to 0.
+ *
+ * \sa CodonAlign::setPrefilter()
+ */
+class HomologyPrefilter
+{
+public:
+  /**
+   * The result of the test.
+   */
+  struct Estimate {
+    unsigned length;        //!< target length (without gaps)
+    unsigned kmers;         //!< k-mers of the target (without ambiguities)
+    unsigned sharedKmers;   //!< k-mers also in the reference
+    int      editDistance;  //!< -1 if not computed
+    double   identity;      //!< 1 - editDistance / length
+    double   predictedScore;
+    bool     accepted;
+
+    Estimate();
+
+    /**
+     * Get the proportion of the k-mers of the target that are in the
+     * reference (1 if the target has no k-mers).
+     */
+    double sharedKmerFraction() const;
+  };
+
+  /**
+   * Create a prefilter for the given reference, using k-mers of size k
+   * (4 - 13).
+   *
+   * The bit map takes 4^k / 8 bytes (512 kB for k = 11).
+   */
+  HomologyPrefilter(const NTSequence& reference, int k = 11);
+
+  /**
+   * Get the reference (without gaps).
+   */
+  const NTSequence& reference() const { return reference_; }
+
+  /**
+   * Set the scores used to predict the alignment score.
+   */
+  void setScores(double matchScore, double editScore);
+
+  /**
+   * Set the minimum predicted alignment score (default 200).
+   */
+  void setMinimumScore(double score) { minimumScore_ = score; }
+
+  /**
+   * Set the minimum proportion of the k-mers of a target that must be
+   * in the reference (default 0.005).
+   *
+   * Unrelated sequences share about L / 4^k of their k-mers by chance
+   * (for a reference of length L), and sequences with identity p
+   * about p^k. The default suits references of up to ten thousand
+   * nucleotides with k = 11, and targets with an identity of more than
+   * about 65%. A value of 0 disables the k-mer stage.
+   */
+  void setMinimumSharedKmerFraction(double fraction) {
+    minimumSharedKmerFraction_ = fraction;
+  }
+
+  /**
+   * Test a target sequence.
+   */
+  Estimate estimate(const NTSequence& target) const;
+
+  /**
+   * Test whether a target sequence is accepted.
+   */
+  bool accept(const NTSequence& target) const {
+    return estimate(target).accepted;
+  }
+
+  /**
+   * Get a hash of the parameters (k, scores and thresholds).
+   */
+  boost::uint64_t parameterHash() const;
+
+  /**
+   * Compute the smallest edit distance between a pattern and any
+   * substring of a text, using Myers' bit-parallel algorithm.
+   *
+   * Nucleotides match if they have a nucleotide in common (see
+   * Nucleotide::mask()). Gaps are ignored.
+   */
+  static int editDistance(const NTSequence& pattern, const NTSequence& text);
+
+private:
+  NTSequence                   reference_;
+  int                          k_;
+  std::vector<boost::uint64_t> kmers_;
+  double                       matchScore_, editScore_;
+  double                       minimumScore_;
+  double                       minimumSharedKmerFraction_;
+};
+
+};
+
+#endif // HOMOLOGY_PREFILTER_H_
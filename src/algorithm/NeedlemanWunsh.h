@@ -18,6 +18,22 @@ class NeedlemanWunsh : public AlignmentAlgorithm
 		   AlignmentAlgorithm::IUB(),
 		   double **aaWeightMatrix = 
 		   AlignmentAlgorithm::BLOSUM30());
+
+  /**
+   * Create an aligner using the given scoring matrices.
+   *
+   * The gap scores are in the same units as the weights of the
+   * matrices (i.e. before multiplication with their scale). When the
+   * gap scores are integers after multiplication with the scale of
+   * the matrices, the alignment is computed using integer arithmetic
+   * (e.g. use NTScoringMatrix::rescaled(10) for a gap extension score
+   * of -3.3).
+   */
+  NeedlemanWunsh(double gapOpenScore,
+		 double gapExtensionScore,
+		 const NTScoringMatrix& ntScoringMatrix,
+		 const AAScoringMatrix& aaScoringMatrix);
+
   /**
    * Pair-wise align two nucleotide sequences, using a modified
    * NeedleMan-Wunsh algorithm.
@@ -44,19 +60,116 @@ class NeedlemanWunsh : public AlignmentAlgorithm
    */
   virtual double align(AASequence& seq1, AASequence& seq2);
 
+  virtual AlignmentTranscript computeAlignment(const NTSequence& seq1,
+					       const NTSequence& seq2);
+
+  virtual AlignmentTranscript computeAlignment(const AASequence& seq1,
+					       const AASequence& seq2);
+
+  /**
+   * Compute the optimal alignment score, using memory linear in the
+   * length of seq2. The result is identical to the score of
+   * computeAlignment().
+   */
+  virtual double computeOptimalScore(const NTSequence& seq1,
+				     const NTSequence& seq2);
+
+  /**
+   * Compute the optimal alignment score, using memory linear in the
+   * length of seq2. The result is identical to the score of
+   * computeAlignment().
+   */
+  virtual double computeOptimalScore(const AASequence& seq1,
+				     const AASequence& seq2);
+
+  virtual double computeOptimalScore(const NTSequenceView& seq1,
+				     const NTSequenceView& seq2);
+
+  virtual double computeOptimalScore(const AASequenceView& seq1,
+				     const AASequenceView& seq2);
+
   virtual double computeAlignScore(const NTSequence& seq1, 
 				   const NTSequence& seq2);
 
+  /**
+   * Compute alignments of long sequences as a tiled wavefront.
+   *
+   * The dynamic programming tables are divided in square tiles of
+   * tileSize x tileSize cells (the default of 256 keeps the working set
+   * of a tile well within a L2 cache). The tiles on an anti-diagonal
+   * are independent, and are computed by up to the given number of
+   * threads in parallel. Only the rows and columns at the tile
+   * boundaries are stored; the traceback recomputes the tiles along
+   * the optimal path. This reduces the memory of computeAlignment()
+   * from (n x m) to about (n + m) x (n + m) / tileSize cells, at the
+   * cost of computing about (n + m) / tileSize tiles twice.
+   *
+   * The wavefront is used when both sequences are longer than
+   * tileSize, and gives identical results. A value of 0 threads (the
+   * default) disables it.
+   */
+  void setWavefront(int threads, int tileSize = 256);
+
+  /**
+   * Get the number of threads for the wavefront (0 if disabled).
+   *
+   * \sa setWavefront()
+   */
+  int wavefrontThreads() const { return wavefrontThreads_; }
+
+  /**
+   * Hashes the gap scores and the scoring matrices.
+   */
+  virtual boost::uint64_t parameterHash() const;
+
 private:
   double gapOpenScore_;
   double gapExtensionScore_;
-  double **ntWeightMatrix_;
-  double **aaWeightMatrix_;
+  bool integerScores_;
+  int scale_;
+  int intGapOpenScore_;
+  int intGapExtensionScore_;
+  NTScoringMatrix ntScoringMatrix_;
+  AAScoringMatrix aaScoringMatrix_;
+  int wavefrontThreads_;
+  int tileSize_;
+
+  void init(double gapOpenScore, double gapExtensionScore,
+	    const NTScoringMatrix& ntScoringMatrix,
+	    const AAScoringMatrix& aaScoringMatrix);
+
+  bool useWavefront(int seq1Size, int seq2Size) const;
+
+  template <typename Symbol>
+  double needlemanWunshAlignInPlace(std::vector<Symbol>& seq1,
+				    std::vector<Symbol>& seq2,
+				    const ScoringMatrix<Symbol>& scoringMatrix);
 
   template <typename Symbol>
-  double needlemanWunshAlign(std::vector<Symbol>& seq1,
-			     std::vector<Symbol>& seq2,
-			     double** weigthMatrix);
+  AlignmentTranscript
+  needlemanWunshAlign(const std::vector<Symbol>& seq1,
+		      const std::vector<Symbol>& seq2,
+		      const ScoringMatrix<Symbol>& scoringMatrix);
+
+  template <typename Sequence>
+  double needlemanWunshScore(const Sequence& seq1,
+			     const Sequence& seq2,
+			     const ScoringMatrix<typename Sequence::value_type>&
+			     scoringMatrix);
+
+  template <typename Score, typename Sequence>
+  Score needlemanWunshScore(const Sequence& seq1,
+			    const Sequence& seq2,
+			    const ScoringMatrix<typename Sequence::value_type>&
+			    scoringMatrix,
+			    Score gapOpenScore, Score gapExtensionScore);
+
+  template <typename Score, typename Symbol>
+  Score needlemanWunshAlign(const std::vector<Symbol>& seq1,
+			    const std::vector<Symbol>& seq2,
+			    const ScoringMatrix<Symbol>& scoringMatrix,
+			    Score gapOpenScore, Score gapExtensionScore,
+			    AlignmentTranscript& transcript);
 };
 
 }
@@ -0,0 +1,178 @@
+// This may look like C code, but it's really -*- C++ -*-
+#ifndef PROFILE_H_
+#define PROFILE_H_
+
+#include <vector>
+#include <stdexcept>
+
+#include <NTSequence.h>
+#include <AASequence.h>
+#include <Alphabet.h>
+
+/**
+ * libseq namespace
+ */
+namespace seq {
+
+/**
+ * The symbol counts per column of a set of aligned sequences, from
+ * which a consensus sequence is derived.
+ *
+ * Sequence is NTSequence or AASequence. The counts of a column are
+ * stored contiguously, indexed by the internal representation of the
+ * symbols. Sequences may be added and removed at any time, so that a
+ * consensus can be updated incrementally.
+ *
+ * \sa NTProfile, AAProfile
+ */
+template <class Sequence>
+class Profile
+{
+public:
+  typedef typename Sequence::value_type Symbol;
+
+  /**
+   * The number of symbols in the alphabet.
+   */
+  static const int SIZE = Alphabet<Symbol>::SIZE;
+
+  /**
+   * Rule for choosing the consensus symbol of a column.
+   */
+  enum Rule {
+    /**
+     * The most frequent symbol other than the gap (ties are resolved
+     * in favour of the symbol with the lowest internal representation).
+     */
+    Majority,
+
+    /**
+     * The most specific symbol that represents at least a fraction
+     * threshold of the sequences without a gap.
+     *
+     * For nucleotides, this is the IUPAC ambiguity code for the
+     * smallest set of nucleotides (most frequent first) whose counts
+     * reach the threshold. An ambiguity symbol in a sequence
+     * contributes equally to each of the nucleotides it represents.
+     *
+     * For amino acids, this is the most frequent amino acid if it
+     * reaches the threshold, otherwise B (D or N), Z (E or Q) or J
+     * (L or I) if these reach the threshold, and X otherwise.
+     */
+    Threshold
+  };
+
+  /**
+   * Create an empty profile for sequences of the given length.
+   */
+  Profile(unsigned length = 0);
+
+  /**
+   * Create a profile of a set of aligned sequences.
+   *
+   * \sa add(const std::vector<Sequence>&, int)
+   */
+  Profile(const std::vector<Sequence>& sequences, int threads = 1);
+
+  /**
+   * Add a sequence.
+   *
+   * The first sequence added to an empty profile of length 0 sets the
+   * length. Throws a std::runtime_error if the sequence length does
+   * not match.
+   */
+  void add(const Sequence& sequence);
+
+  /**
+   * Add a set of sequences.
+   *
+   * The columns are divided in blocks that are counted by the given
+   * number of threads.
+   */
+  void add(const std::vector<Sequence>& sequences, int threads = 1);
+
+  /**
+   * Remove a sequence, which must have been added before.
+   */
+  void remove(const Sequence& sequence);
+
+  /**
+   * Remove a set of sequences, which must have been added before.
+   */
+  void remove(const std::vector<Sequence>& sequences, int threads = 1);
+
+  /**
+   * Get the number of columns.
+   */
+  unsigned length() const { return length_; }
+
+  /**
+   * Get the number of sequences.
+   */
+  unsigned sequenceCount() const { return sequenceCount_; }
+
+  /**
+   * Get the number of sequences with symbol s in a column.
+   */
+  unsigned count(unsigned column, const Symbol s) const {
+    return counts_[column * Alphabet<Symbol>::STRIDE + s.intRep()];
+  }
+
+  /**
+   * Get the counts of a column, indexed by the internal representation
+   * of the symbols.
+   */
+  const unsigned *counts(unsigned column) const {
+    return &counts_[column * Alphabet<Symbol>::STRIDE];
+  }
+
+  /**
+   * Compute the consensus sequence.
+   *
+   * A column is a gap in the consensus if the fraction of sequences
+   * with a gap is at least gapThreshold. With the default of 1, only
+   * columns that are a gap in all sequences are a gap, while 0.5 gives
+   * a gap-aware consensus in which a column is a gap when most
+   * sequences have a gap. Otherwise, the consensus symbol is chosen
+   * from the other symbols according to rule.
+   *
+   * Columns without symbols (e.g. when the profile is empty) are N
+   * or X.
+   */
+  Sequence consensus(Rule rule = Majority, double threshold = 0.5,
+		     double gapThreshold = 1) const;
+
+  /**
+   * Get the consensus symbol of a single column.
+   *
+   * \sa consensus()
+   */
+  Symbol consensus(unsigned column, Rule rule = Majority,
+		   double threshold = 0.5, double gapThreshold = 1) const;
+
+private:
+  unsigned length_;
+  unsigned sequenceCount_;
+  std::vector<unsigned> counts_;
+
+  void update(const std::vector<Sequence>& sequences, int delta,
+	      int threads);
+  void checkLength(const Sequence& sequence);
+
+  static Symbol majoritySymbol(const unsigned *counts);
+  static Symbol thresholdSymbol(const unsigned *counts, double threshold);
+};
+
+/**
+ * A profile of aligned nucleotide sequences.
+ */
+typedef Profile<NTSequence> NTProfile;
+
+/**
+ * A profile of aligned amino acid sequences.
+ */
+typedef Profile<AASequence> AAProfile;
+
+};
+
+#endif // PROFILE_H_
@@ -0,0 +1,130 @@
+// This may look like C code, but it's really -*- C++ -*-
+#ifndef REFERENCE_ALIGNMENT_MERGER_H_
+#define REFERENCE_ALIGNMENT_MERGER_H_
+
+#include <vector>
+#include <stdexcept>
+
+#include <NTSequence.h>
+
+/**
+ * libseq namespace
+ */
+namespace seq {
+
+/**
+ * Merges pair-wise alignments against a common reference into a
+ * multiple alignment.
+ *
+ * Every pair-wise alignment (e.g. computed with CodonAlign::align())
+ * consists of the aligned reference and the aligned target. Columns
+ * in which the aligned reference has a gap are insertions relative to
+ * the reference. The merged alignment reserves, before every
+ * reference position, room for the longest insertion found at that
+ * position in any of the pair-wise alignments.
+ *
+ * Merging happens in two passes: first all pair-wise alignments are
+ * collect()'ed, which only records the maximum insertion length for
+ * every reference position. Then every target is laid out once
+ * against the merged alignment using layout(). This allows to merge
+ * alignments that are streamed from disk, without keeping them in
+ * memory. Partial results, e.g. computed by different threads, may be
+ * combined using merge(const ReferenceAlignmentMerger&).
+ *
+ * Optionally, insertion columns are dropped altogether, so that the
+ * merged alignment is in reference coordinates.
+ */
+class ReferenceAlignmentMerger
+{
+public:
+  /**
+   * Create a merger for alignments against a reference of the given
+   * (ungapped) length.
+   *
+   * If keepInsertions = false, columns that are insertions relative
+   * to the reference are removed from the merged alignment.
+   */
+  ReferenceAlignmentMerger(unsigned referenceLength,
+			   bool keepInsertions = true);
+
+  /**
+   * Record the insertions of a pair-wise alignment.
+   *
+   * Both sequences must have equal length, and the aligned reference
+   * (with gaps removed) must have the reference length.
+   */
+  void collect(const NTSequence& alignedRef, const NTSequence& alignedTarget);
+
+  /**
+   * Record the insertions of another merger, with the same reference
+   * length.
+   *
+   * @throws std::runtime_error if the reference lengths differ.
+   */
+  void merge(const ReferenceAlignmentMerger& other);
+
+  /**
+   * Get the length of the merged alignment.
+   */
+  unsigned alignmentLength() const;
+
+  /**
+   * Get the reference sequence as it appears in the merged
+   * alignment, given the reference sequence (or an aligned
+   * reference).
+   */
+  NTSequence layoutReference(const NTSequence& reference) const;
+
+  /**
+   * Lay out a pair-wise aligned target in the merged alignment.
+   *
+   * The pair-wise alignment must have been collect()'ed, unless
+   * insertions are dropped. Since the merger is not modified, targets
+   * may be laid out concurrently by different threads. Residues
+   * inserted before the first reference position are right-justified,
+   * all other insertions are left-justified. The result has the name
+   * and description of the aligned target.
+   */
+  NTSequence layout(const NTSequence& alignedRef,
+		    const NTSequence& alignedTarget) const;
+
+  /**
+   * Get the maximum insertion length before reference position pos.
+   *
+   * Position referenceLength() corresponds to insertions after the
+   * last reference position.
+   */
+  unsigned insertionLength(unsigned pos) const { return insertions_[pos]; }
+
+  /**
+   * Get the reference length.
+   */
+  unsigned referenceLength() const { return insertions_.size() - 1; }
+
+  /**
+   * Merge a set of pair-wise alignments into a multiple alignment.
+   *
+   * Both passes are performed using the given number of threads. The
+   * result contains the reference (first), followed by all targets.
+   *
+   * @throws std::runtime_error if alignedRefs and alignedTargets have
+   * a different size, or an alignment does not match the reference.
+   */
+  static void merge(const NTSequence& reference,
+		    const std::vector<NTSequence>& alignedRefs,
+		    const std::vector<NTSequence>& alignedTargets,
+		    std::vector<NTSequence>& result,
+		    bool keepInsertions = true,
+		    int threads = 1);
+
+private:
+  bool keepInsertions_;
+  std::vector<unsigned> insertions_;
+  std::vector<unsigned> offsets_;
+
+  void computeOffsets();
+};
+
+};
+
+#endif // REFERENCE_ALIGNMENT_MERGER_H_
@@ -0,0 +1,182 @@
+// This may look like C code, but it's really -*- C++ -*-
+#ifndef REFERENCE_INDEX_H_
+#define REFERENCE_INDEX_H_
+
+#include <vector>
+#include <string>
+#include <iostream>
+#include <boost/cstdint.hpp>
+
+#include <NTSequence.h>
+#include <ParseException.h>
+
+/**
+ * libseq namespace
+ */
+namespace seq {
+
+/**
+ * A minimizer index over a panel of reference sequences.
+ *
+ * The index is used to quickly select the most similar references
+ * from a (large) panel for a query sequence, so that only these need
+ * to be aligned using e.g. CodonAlign.
+ *
+ * For every reference, the (k, w)-minimizers are stored: within each
+ * window of w consecutive k-mers, the k-mer with the smallest hash
+ * value. K-mers that contain an ambiguity symbol are skipped, and
+ * gaps are ignored (so that aligned references may be indexed as
+ * well).
+ *
+ * Candidates for a query are ranked by the number of minimizer hits
+ * that lie on a consistent diagonal (within a band), and secondly by
+ * the total number of shared minimizers.
+ *
+ * The index may be saved to and loaded from a stream, so that it
+ * needs to be built only once for a given panel.
+ */
+class ReferenceIndex
+{
+public:
+  /**
+   * A candidate reference for a query.
+   */
+  struct Candidate {
+    /**
+     * Index of the reference in the panel.
+     */
+    int reference;
+
+    /**
+     * Number of query minimizers that are present in the reference.
+     */
+    int sharedMinimizers;
+
+    /**
+     * Number of minimizer hits within the best diagonal band.
+     */
+    int diagonalHits;
+
+    /**
+     * Diagonal (reference position - query position) of the best band.
+     */
+    int diagonal;
+  };
+
+  /**
+   * Create an empty index, using k-mers of size k (at most 31) and
+   * windows of w k-mers.
+   *
+   * @throws std::runtime_error if k or w is out of range.
+   */
+  ReferenceIndex(int k = 15, int w = 10);
+
+  /**
+   * Create an index for the given reference panel.
+   *
+   * @throws std::runtime_error if k or w is out of range.
+   */
+  ReferenceIndex(const std::vector<NTSequence>& panel, int k = 15, int w = 10);
+
+  /**
+   * Add a reference to the index, and return its index in the panel.
+   */
+  int addReference(const NTSequence& reference);
+
+  /**
+   * Get the number of references in the index.
+   */
+  int referenceCount() const { return names_.size(); }
+
+  /**
+   * Get the name of a reference.
+   */
+  const std::string& referenceName(int reference) const {
+    return names_[reference];
+  }
+
+  /**
+   * Get the (ungapped) length of a reference.
+   */
+  int referenceLength(int reference) const { return lengths_[reference]; }
+
+  /**
+   * Get the k-mer size.
+   */
+  int k() const { return k_; }
+
+  /**
+   * Get the window size.
+   */
+  int w() const { return w_; }
+
+  /**
+   * Set the width of the diagonal band used to collect consistent
+   * minimizer hits, which determines the tolerance for indels
+   * (default: 50).
+   */
+  void setBandWidth(int width) { bandWidth_ = width; }
+
+  /**
+   * Rank the references for the given query.
+   *
+   * At most maxCandidates candidates are returned (all if 0), with the
+   * best candidate first. References that share no minimizers with the
+   * query are not returned.
+   */
+  std::vector<Candidate> rank(const NTSequence& query,
+			      unsigned maxCandidates = 5) const;
+
+  /**
+   * Save the index in a binary format to the given stream.
+   */
+  void write(std::ostream& o) const;
+
+  /**
+   * Load an index, saved with write(), from the given stream,
+   * replacing the current index.
+   *
+   * @throws ParseException if the stream is not a valid index (the
+   * index is then unchanged).
+   */
+  void read(std::istream& i)
+    throw (ParseException);
+
+  /// \cond
+  struct Minimizer {
+    boost::uint64_t hash;
+    boost::uint32_t pos;
+  };
+
+  struct Entry {
+    boost::uint64_t hash;
+    boost::uint32_t reference;
+    boost::uint32_t pos;
+
+    bool operator< (const Entry& other) const {
+      return hash < other.hash
+	|| (hash == other.hash
+	    && (reference < other.reference
+		|| (reference == other.reference && pos < other.pos)));
+    }
+  };
+  /// \endcond
+
+  /**
+   * Compute the (k, w)-minimizers of a sequence.
+   *
+   * Positions are positions in the sequence with gaps removed.
+   */
+  static void minimizers(const NTSequence& sequence, int k, int w,
+			 std::vector<Minimizer>& result);
+
+private:
+  int k_, w_, bandWidth_;
+  std::vector<std::string> names_;
+  std::vector<int> lengths_;
+  std::vector<Entry> entries_; // sorted
+};
+
+};
+
+#endif // REFERENCE_INDEX_H_
@@ -0,0 +1,143 @@
+// This may look like C code, but it's really -*- C++ -*-
+#ifndef SCORING_MATRIX_H_
+#define SCORING_MATRIX_H_
+
+#include <iostream>
+#include <boost/cstdint.hpp>
+
+#include <ParseException.h>
+#include <Alphabet.h>
+
+/**
+ * libseq namespace
+ */
+namespace seq {
+
+/**
+ * An integer similarity weights matrix for nucleotides or amino acids.
+ *
+ * Scores are stored as integers, which are the actual weights
+ * multiplied by scale(). The matrix covers all symbols of the alphabet
+ * (including the gap and ambiguity symbols), and is stored in a flat
+ * array with a power-of-two row stride, so that a score lookup is a
+ * single load. With GCC, the array is aligned on a (64 byte) cache
+ * line.
+ *
+ * \sa NTScoringMatrix, AAScoringMatrix
+ */
+template <class Symbol>
+class ScoringMatrix
+{
+public:
+  /**
+   * The number of symbols in the alphabet.
+   */
+  static const int SIZE = Alphabet<Symbol>::SIZE;
+
+  /**
+   * Create a matrix with all scores 0.
+   */
+  ScoringMatrix(int scale = 1);
+
+  /**
+   * Create a matrix from a size x size matrix of weights, indexed by
+   * the internal representation of the symbols.
+   *
+   * The scale is chosen as the smallest power of 10 (up to 1000)
+   * for which all weights are integers; otherwise weights are rounded
+   * at a scale of 1000. Symbols that are not covered by the weights
+   * matrix are scored as described in load().
+   */
+  ScoringMatrix(double **weights, int size);
+
+  /**
+   * Read a matrix in the format used by NCBI (e.g. BLOSUM62, NUC.4.4).
+   *
+   * Lines starting with '#' are comments. The first other line lists
+   * the symbols of the columns, and every next line starts with the
+   * symbol of the row followed by a weight for every column. Weights
+   * are multiplied by the given scale, and rounded.
+   *
+   * Symbols that are not part of the alphabet (e.g. '*' for
+   * nucleotides) are ignored. Symbols that are missing from the file
+   * are scored like the symbol for 'any' (N or X) when present, except
+   * for the gap symbol, which scores 0.
+   */
+  static ScoringMatrix load(std::istream& s, int scale = 1)
+    throw (ParseException);
+
+  /**
+   * Get the score for aligning two symbols.
+   */
+  int operator()(const Symbol a, const Symbol b) const {
+    return scores_[a.intRep() * Alphabet<Symbol>::STRIDE + b.intRep()];
+  }
+
+  /**
+   * Get the scores for aligning a symbol with every other symbol,
+   * indexed by their internal representation.
+   */
+  const int *row(const Symbol a) const {
+    return scores_ + a.intRep() * Alphabet<Symbol>::STRIDE;
+  }
+
+  /**
+   * Set the score for aligning two symbols (in both directions).
+   */
+  void set(const Symbol a, const Symbol b, int score);
+
+  /**
+   * Get the weight for aligning two symbols: the score divided by
+   * scale().
+   */
+  double weight(const Symbol a, const Symbol b) const {
+    return (double)(*this)(a, b) / scale_;
+  }
+
+  /**
+   * Get the scale.
+   */
+  int scale() const { return scale_; }
+
+  /**
+   * Get a copy of this matrix, with all scores multiplied by factor.
+   */
+  ScoringMatrix rescaled(int factor) const;
+
+  /**
+   * Get a hash of the scale and all scores.
+   *
+   * \sa Hash
+   */
+  boost::uint64_t hash() const;
+
+private:
+  int scale_;
+
+  /*
+   * cache line aligned, so that a row spans as few cache lines as
+   * possible (operator new may not honor this in C++98)
+   */
+#ifdef __GNUC__
+  int scores_[Alphabet<Symbol>::SIZE * Alphabet<Symbol>::STRIDE]
+    __attribute__((aligned(64)));
+#else
+  int scores_[Alphabet<Symbol>::SIZE * Alphabet<Symbol>::STRIDE];
+#endif
+
+  void complete(const bool *present);
+};
+
+/**
+ * A scoring matrix for nucleotides.
+ */
+typedef ScoringMatrix<Nucleotide> NTScoringMatrix;
+
+/**
+ * A scoring matrix for amino acids.
+ */
+typedef ScoringMatrix<AminoAcid> AAScoringMatrix;
+
+};
+
+#endif // SCORING_MATRIX_H_
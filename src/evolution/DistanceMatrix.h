@@ -0,0 +1,115 @@
+// This may look like C code, but it's really -*- C++ -*-
+#ifndef DISTANCE_MATRIX_H_
+#define DISTANCE_MATRIX_H_
+
+#include <algorithm>
+#include <string>
+#include <vector>
+#include <stdexcept>
+
+namespace seq {
+
+/**
+ * A symmetric matrix of pair-wise distances between named taxa.
+ *
+ * Only the lower half of the matrix is stored, row after row, so that
+ * a matrix of n taxa takes n (n - 1) / 2 values. Value is double or
+ * float: a matrix of floats takes half the memory, which matters for
+ * tens of thousands of taxa (e.g. 5 GB instead of 10 GB for 50000
+ * taxa).
+ *
+ * \sa NeighborJoining
+ */
+template <typename Value>
+class DistanceMatrix
+{
+public:
+  typedef Value value_type;
+
+  /**
+   * Create a matrix for size taxa, with all distances 0 and empty
+   * names.
+   */
+  DistanceMatrix(unsigned size = 0)
+    : size_(size),
+      values_(index(size, 0), 0),
+      names_(size)
+  { }
+
+  /**
+   * Create a matrix for the given taxa, with all distances 0.
+   */
+  DistanceMatrix(const std::vector<std::string>& names)
+    : size_(names.size()),
+      values_(index(names.size(), 0), 0),
+      names_(names)
+  { }
+
+  /**
+   * Get the number of taxa.
+   */
+  unsigned size() const { return size_; }
+
+  /**
+   * Get the distance between taxa i and j (0 if i == j).
+   */
+  Value operator()(unsigned i, unsigned j) const {
+    if (i == j)
+      return 0;
+    else
+      return values_[i > j ? index(i, j) : index(j, i)];
+  }
+
+  /**
+   * Set the distance between taxa i and j (i != j).
+   */
+  void set(unsigned i, unsigned j, Value distance) {
+    if (i == j)
+      throw std::runtime_error("DistanceMatrix::set(): i == j");
+    values_[i > j ? index(i, j) : index(j, i)] = distance;
+  }
+
+  /**
+   * Get the name of taxon i.
+   */
+  const std::string& name(unsigned i) const { return names_[i]; }
+
+  /**
+   * Set the name of taxon i.
+   */
+  void setName(unsigned i, const std::string& name) { names_[i] = name; }
+
+  /**
+   * Get the names of all taxa.
+   */
+  const std::vector<std::string>& names() const { return names_; }
+
+  /**
+   * Get the distances of row i with the taxa j < i.
+   */
+  const Value *row(unsigned i) const {
+    return values_.empty() ? 0 : &values_[0] + index(i, 0);
+  }
+
+  /**
+   * Exchange the contents with another matrix.
+   */
+  void swap(DistanceMatrix& other) {
+    std::swap(size_, other.size_);
+    values_.swap(other.values_);
+    names_.swap(other.names_);
+  }
+
+private:
+  unsigned size_;
+  std::vector<Value> values_;
+  std::vector<std::string> names_;
+
+  static std::size_t index(unsigned i, unsigned j) {
+    return (std::size_t)i * (i - 1) / 2 + j;
+  }
+};
+
+};
+
+#endif // DISTANCE_MATRIX_H_
@@ -0,0 +1,150 @@
+// This may look like C code, but it's really -*- C++ -*-
+#ifndef NEI_GOJOBORI_H_
+#define NEI_GOJOBORI_H_
+
+#include <vector>
+
+#include "NTSequence.h"
+#include "SequenceView.h"
+#include "DistanceMatrix.h"
+
+namespace seq {
+
+/**
+ * Computes synonymous and non-synonymous distances (dS and dN) between
+ * aligned coding sequences, using the method of Nei and Gojobori
+ * (1986).
+ *
+ * The synonymous sites of every codon, and the synonymous and
+ * non-synonymous differences between every pair of codons, are
+ * computed once, in tables of 64 and 64 x 64 entries. Comparing two
+ * sequences then only takes a table lookup per codon, which makes it
+ * feasible to compute all pairs of thousands of sequences. Pairs of
+ * sequences are compared by the given number of threads.
+ *
+ * The number of synonymous sites of a codon is the sum, over its
+ * three positions, of the proportion of the three possible mutations
+ * that are synonymous (a mutation to a stop codon is non-synonymous).
+ * Codons that differ at more than one position are compared by
+ * averaging over all mutation pathways that do not pass through a
+ * stop codon. The proportions of differences are corrected for
+ * multiple hits using the Jukes-Cantor formula.
+ *
+ * Codons are compared by position in the alignment, from the start of
+ * the sequences. A codon with a gap, or a stop codon, is skipped
+ * (pairwise deletion). A codon with ambiguity codes is averaged over
+ * all its non-stop resolutions.
+ */
+class NeiGojobori
+{
+public:
+  /**
+   * The comparison of two coding sequences.
+   */
+  struct Result {
+    unsigned codons;                 //!< number of codons compared
+    double   synonymousSites;        //!< S
+    double   nonSynonymousSites;     //!< N
+    double   synonymousDifferences;  //!< Sd
+    double   nonSynonymousDifferences; //!< Nd
+
+    Result();
+
+    /**
+     * Get the proportion of synonymous differences (Sd / S).
+     */
+    double pS() const;
+
+    /**
+     * Get the proportion of non-synonymous differences (Nd / N).
+     */
+    double pN() const;
+
+    /**
+     * Get the synonymous distance.
+     *
+     * This is NaN when no synonymous sites were compared, and infinity
+     * when pS() >= 3/4 (the Jukes-Cantor correction is undefined).
+     */
+    double dS() const;
+
+    /**
+     * Get the non-synonymous distance.
+     *
+     * \sa dS()
+     */
+    double dN() const;
+
+    /**
+     * Get dN / dS.
+     */
+    double ratio() const { return dN() / dS(); }
+  };
+
+  /**
+   * Create a dN/dS calculator, using the given number of threads.
+   */
+  NeiGojobori(int threads = 1);
+
+  /**
+   * Compare two aligned coding sequences.
+   *
+   * Throws a std::runtime_error if the sequences have a different
+   * length.
+   */
+  Result compare(const NTSequence& seq1, const NTSequence& seq2) const;
+
+  /**
+   * Compare two views on aligned coding sequences, such as the same
+   * gene region of two aligned genomes, without copying them.
+   *
+   * Throws a std::runtime_error if the views have a different length.
+   */
+  Result compare(const NTSequenceView& seq1, const NTSequenceView& seq2)
+    const;
+
+  /**
+   * Compare every sequence to a reference sequence.
+   *
+   * The results are stored in results, which is resized to the number
+   * of sequences. Throws a std::runtime_error if the sequences have a
+   * different length.
+   */
+  void compare(const NTSequence& reference,
+	       const std::vector<NTSequence>& sequences,
+	       std::vector<Result>& results) const;
+
+  /**
+   * Compare all pairs of aligned sequences.
+   *
+   * The matrices are resized to the number of sequences, and the
+   * sequence names are used as taxon names. Throws a
+   * std::runtime_error if the sequences have a different length.
+   */
+  void pairwise(const std::vector<NTSequence>& sequences,
+		DistanceMatrix<float>& dN,
+		DistanceMatrix<float>& dS,
+		DistanceMatrix<float>& ratio) const;
+
+  /**
+   * Get the number of synonymous sites of a non-ambiguous codon.
+   *
+   * The number of non-synonymous sites is 3 minus this number.
+   */
+  static double synonymousSites(const NTSequence::const_iterator codon);
+
+  /**
+   * Get the number of synonymous and non-synonymous differences
+   * between two non-ambiguous codons.
+   */
+  static void differences(const NTSequence::const_iterator codon1,
+			  const NTSequence::const_iterator codon2,
+			  double& synonymous, double& nonSynonymous);
+
+private:
+  int threads_;
+};
+
+};
+
+#endif // NEI_GOJOBORI_H_
@@ -0,0 +1,199 @@
+// This may look like C code, but it's really -*- C++ -*-
+#ifndef NEIGHBOR_INDEX_H_
+#define NEIGHBOR_INDEX_H_
+
+#include <string>
+#include <vector>
+#include <boost/cstdint.hpp>
+#include <boost/unordered_map.hpp>
+
+#include "NTSequence.h"
+#include "NameTable.h"
+
+namespace seq {
+
+/**
+ * An index over a database of aligned nucleotide sequences, to find
+ * the database sequences within a genetic distance of a query
+ * sequence (e.g. for detecting transmission clusters), without
+ * comparing the query with every database sequence.
+ *
+ * The distance between two aligned sequences is the proportion of
+ * mismatches among the sites at which neither sequence has a gap.
+ * Nucleotides that have a nucleotide in common (see
+ * Nucleotide::mask()) match, so that an ambiguity does not count as a
+ * mismatch with any of the nucleotides it represents.
+ *
+ * Every sequence is stored as four bit planes (one for each of A, C,
+ * G and T), so that the distance is computed for 64 sites at once.
+ *
+ * The alignment is divided in segments: a query and a database
+ * sequence at a distance of at most d have at most k = d * L
+ * mismatches (for an alignment length L), and thus at least q - k of
+ * the q segments without a mismatch (the pigeonhole principle). For
+ * every segment, the database sequences are hashed on their content.
+ * A segment with a gap or an ambiguity, in either sequence, may match
+ * without being identical, and counts as a possible match. Only the
+ * database sequences with at least q - k possible matches are
+ * compared with the query, and these are usually only the actual
+ * neighbors: the filter does not miss any neighbor.
+ *
+ * The segments are chosen for a maximum distance (given when creating
+ * the index). Queries for a much larger distance, or queries with too
+ * many gaps or ambiguities to filter, compare the query with every
+ * database sequence.
+ *
+ * Sequences may be added at any time, but not while queries are
+ * running. Queries may run concurrently, and a batch of queries is
+ * run by the given number of threads.
+ */
+class NeighborIndex
+{
+public:
+  /**
+   * A database sequence found for a query.
+   */
+  struct Neighbor {
+    unsigned sequence;   //!< index in the database
+    unsigned mismatches; //!< number of incompatible sites
+    unsigned sites;      //!< number of sites without a gap in either
+
+    /**
+     * Get the distance: mismatches / sites (0 if sites is 0).
+     */
+    double distance() const {
+      return sites ? (double)mismatches / sites : 0;
+    }
+
+    /**
+     * Order by distance, and by index in the database.
+     */
+    bool operator< (const Neighbor& other) const;
+  };
+
+  /**
+   * Create an empty index for alignments of the given length, to find
+   * neighbors within at most maxDistance, and running batches of
+   * queries with the given number of threads.
+   */
+  NeighborIndex(unsigned length, double maxDistance = 0.015,
+		int threads = 1);
+
+  /**
+   * Get the alignment length.
+   */
+  unsigned length() const { return length_; }
+
+  /**
+   * Get the maximum distance for which queries are filtered.
+   */
+  double maxDistance() const { return maxDistance_; }
+
+  /**
+   * Get the number of sequences.
+   */
+  unsigned size() const { return nameHandles_.size(); }
+
+  /**
+   * Get the name of a sequence.
+   */
+  std::string name(unsigned sequence) const {
+    return names_.str(nameHandles_[sequence]);
+  }
+
+  /**
+   * Set the minimum number of sites without gaps in both sequences for
+   * a database sequence to be a neighbor (default 1).
+   */
+  void setMinimumSites(unsigned sites) { minimumSites_ = sites; }
+
+  /**
+   * Add an aligned sequence, and return its index in the database.
+   *
+   * The sequence must have the alignment length.
+   */
+  unsigned insert(const NTSequence& sequence);
+
+  /**
+   * Add aligned sequences.
+   */
+  void insert(const std::vector<NTSequence>& sequences);
+
+  /**
+   * Find all database sequences within a distance (inclusive) of an
+   * aligned query, ordered by distance.
+   */
+  std::vector<Neighbor> within(const NTSequence& query,
+			       double distance) const;
+
+  /**
+   * Find the k nearest database sequences of an aligned query, ordered
+   * by distance.
+   *
+   * When fewer than k sequences are within maxDistance(), the query is
+   * compared with every database sequence.
+   */
+  std::vector<Neighbor> nearest(const NTSequence& query, unsigned k) const;
+
+  /**
+   * Run within() for a batch of queries, using the threads of the
+   * index.
+   */
+  void within(const std::vector<NTSequence>& queries, double distance,
+	      std::vector<std::vector<Neighbor> >& result) const;
+
+  /**
+   * Run nearest() for a batch of queries, using the threads of the
+   * index.
+   */
+  void nearest(const std::vector<NTSequence>& queries, unsigned k,
+	       std::vector<std::vector<Neighbor> >& result) const;
+
+  /**
+   * Compare two database sequences.
+   */
+  Neighbor compare(unsigned sequence1, unsigned sequence2) const;
+
+  /// \cond
+  typedef boost::uint64_t Word;
+  class Query;
+  /// \endcond
+
+private:
+  typedef boost::unordered_map<Word, boost::uint32_t> SegmentTable;
+
+  unsigned length_;
+  double   maxDistance_;
+  int      threads_;
+  unsigned minimumSites_;
+  unsigned words_;        // per bit plane
+
+  NameTable         names_;
+  std::vector<int>  nameHandles_;
+  std::vector<Word> planes_;      // words_ * 4 per sequence
+
+  /*
+   * segment s covers sites [segmentStarts_[s], segmentStarts_[s + 1][
+   */
+  std::vector<unsigned>        segmentStarts_;
+  std::vector<SegmentTable>    segmentHeads_; // by content hash
+  std::vector<boost::uint32_t> wildHeads_;    // with gaps or ambiguities
+  std::vector<boost::uint32_t> next_;         // per sequence and segment
+
+  unsigned segmentCount() const { return segmentStarts_.size() - 1; }
+  const Word *planes(unsigned sequence) const {
+    return &planes_[(std::size_t)sequence * words_ * 4];
+  }
+
+  bool segmentHash(const NTSequence& sequence, unsigned segment,
+		   Word& hash) const;
+  bool candidates(const Query& query, unsigned mismatches,
+		  std::vector<boost::uint32_t>& result) const;
+  void search(const Query& query, double distance, bool filter,
+	      std::vector<Neighbor>& result) const;
+  void checkLengths(const std::vector<NTSequence>& queries) const;
+};
+
+};
+
+#endif // NEIGHBOR_INDEX_H_
@@ -0,0 +1,66 @@
+// This may look like C code, but it's really -*- C++ -*-
+#ifndef NEIGHBOR_JOINING_H_
+#define NEIGHBOR_JOINING_H_
+
+#include "DistanceMatrix.h"
+#include "Tree.h"
+
+namespace seq {
+
+/**
+ * Builds a phylogenetic tree from a distance matrix using the
+ * neighbor-joining method (Saitou and Nei, 1987).
+ *
+ * Every iteration joins the two active nodes i and j with the
+ * smallest value of Q(i, j) = (n - 2) d(i, j) - r(i) - r(j), where n
+ * is the number of active nodes and r(i) the sum of the distances of
+ * i. Instead of evaluating Q for all n^2 pairs, the search follows
+ * RapidNJ (Simonsen et al., 2008): the distances of every row are kept
+ * sorted, and a row is only scanned while
+ * (n - 2) d(i, j) - r(i) - max(r) can still improve the best Q found
+ * so far. For tree-like data, this visits only a small fraction of
+ * the pairs, making trees of tens of thousands of taxa feasible
+ * (without tree structure, e.g. for a star phylogeny, most pairs are
+ * still visited).
+ *
+ * The rows are searched by the given number of threads. Ties are
+ * resolved independently of the number of threads, so that the
+ * result does not depend on it.
+ *
+ * The sorted rows take n (n - 1) / 2 entries of a distance and a
+ * 32-bit index, in addition to the distance matrix, so that using
+ * DistanceMatrix<float> halves the memory.
+ *
+ * The resulting tree is unrooted: its root has three children. Leaf
+ * i of the tree is taxon i of the matrix. Branch lengths may be
+ * negative, as is usual for neighbor-joining.
+ */
+class NeighborJoining
+{
+public:
+  /**
+   * Create a tree builder, using the given number of threads.
+   */
+  NeighborJoining(int threads = 1);
+
+  /**
+   * Build the tree for a distance matrix.
+   */
+  template <typename Value>
+  Tree build(const DistanceMatrix<Value>& distances) const;
+
+  /**
+   * Build the tree for a distance matrix, using the matrix as working
+   * memory: this avoids a copy of the matrix, but the distances are
+   * overwritten.
+   */
+  template <typename Value>
+  Tree buildInPlace(DistanceMatrix<Value>& distances) const;
+
+private:
+  int threads_;
+};
+
+};
+
+#endif // NEIGHBOR_JOINING_H_
@@ -0,0 +1,220 @@
+// This may look like C code, but it's really -*- C++ -*-
+#ifndef SITE_PATTERNS_H_
+#define SITE_PATTERNS_H_
+
+#include <vector>
+#include <boost/cstdint.hpp>
+#include <boost/thread.hpp>
+
+#include "NTSequence.h"
+#include "SequenceView.h"
+#include "Random.h"
+#include "DistanceMatrix.h"
+
+namespace seq {
+
+/**
+ * The unique site patterns (alignment columns) of a set of aligned
+ * nucleotide sequences.
+ *
+ * Sites with identical columns are stored once, with a weight: the
+ * number of sites with that pattern. Statistics are computed from the
+ * weighted patterns, and can therefore also be computed for any other
+ * weighting of the patterns, such as a bootstrap replicate: resampling
+ * the sites with replacement only changes the weights. Thus, hundreds
+ * of replicates are computed without copying sequences, and in
+ * parallel (see bootstrap()).
+ *
+ * Symbols are compared exactly (like Nucleotide::operator==), so that
+ * gaps and ambiguity codes are treated as distinct symbols, except
+ * where noted.
+ */
+class SitePatterns
+{
+public:
+  /**
+   * The weight of every pattern.
+   */
+  typedef std::vector<unsigned> Weights;
+
+  /**
+   * Compute the site patterns of a set of aligned sequences.
+   *
+   * Throws a std::runtime_error if the sequences do not have equal
+   * length.
+   */
+  SitePatterns(const std::vector<NTSequence>& alignment);
+
+  /**
+   * Compute the site patterns of a set of views on aligned sequences,
+   * such as the same region of a set of aligned sequences, without
+   * copying the region.
+   *
+   * Throws a std::runtime_error if the views do not have equal
+   * length.
+   */
+  SitePatterns(const std::vector<NTSequenceView>& alignment);
+
+  /**
+   * Get the number of sequences.
+   */
+  unsigned sequenceCount() const { return sequenceCount_; }
+
+  /**
+   * Get the number of sites.
+   */
+  unsigned siteCount() const { return sitePatterns_.size(); }
+
+  /**
+   * Get the number of unique patterns.
+   */
+  unsigned patternCount() const { return weights_.size(); }
+
+  /**
+   * Get the symbol of a sequence in a pattern.
+   */
+  Nucleotide symbol(unsigned pattern, unsigned sequence) const {
+    return Nucleotide::fromRep(symbols_[sequence * patternCount() + pattern]);
+  }
+
+  /**
+   * Get the pattern of a site.
+   */
+  unsigned sitePattern(unsigned site) const { return sitePatterns_[site]; }
+
+  /**
+   * Get the weights of the alignment: the number of sites of every
+   * pattern.
+   */
+  const Weights& weights() const { return weights_; }
+
+  /**
+   * Get the weights of a bootstrap replicate: siteCount() sites are
+   * sampled with replacement.
+   */
+  void resample(Random& random, Weights& weights) const;
+
+  /**
+   * Compute a statistic for bootstrap replicates.
+   *
+   * The function f is called with the Weights of every replicate, and
+   * its results are stored in results (which is resized to
+   * replicates). For example:
+   * \code
+   * std::vector<double> d;
+   * patterns.bootstrap(1000, seed,
+   *                    boost::bind(&SitePatterns::tajimaD, &patterns, _1),
+   *                    d, 4);
+   * \endcode
+   *
+   * Replicate r is sampled using Random(seed, r), so that the results
+   * do not depend on the number of threads.
+   */
+  template <class Result, class Function>
+  void bootstrap(unsigned replicates, boost::uint64_t seed, Function f,
+		 std::vector<Result>& results, int threads = 1) const;
+
+  /**
+   * Get the number of segregating sites: sites at which not all
+   * sequences have the same symbol.
+   */
+  double segregatingSites(const Weights& weights) const;
+
+  /**
+   * Get the average number of differences between pairs of sequences.
+   *
+   * @throws std::runtime_error if there are fewer than 2 sequences.
+   */
+  double pairwiseDifferences(const Weights& weights) const;
+
+  /**
+   * Get Tajima's D statistic, from the number of segregating sites
+   * and the average number of pair-wise differences.
+   *
+   * @throws std::runtime_error if there are fewer than 2 sequences.
+   */
+  double tajimaD(const Weights& weights) const;
+
+  /**
+   * Get the genetic diversity between two groups of sequences: the
+   * proportion of differing symbols between all pairs of a sequence
+   * of the first group (the sequences before split) and a sequence of
+   * the second group (the other sequences), ignoring gaps.
+   */
+  double diversity(unsigned split, const Weights& weights) const;
+
+  /**
+   * Get the proportion of differing symbols between all pairs of
+   * sequences (p-distance), ignoring sites with a gap in either
+   * sequence.
+   */
+  DistanceMatrix<float> distances(const Weights& weights) const;
+
+private:
+  unsigned sequenceCount_;
+  std::vector<unsigned char> symbols_; // sequence after sequence
+  Weights weights_;
+  std::vector<unsigned> sitePatterns_;
+
+  /*
+   * per pattern: whether it is segregating, and the number of pairs
+   * of sequences that differ
+   */
+  std::vector<bool> segregating_;
+  std::vector<double> differingPairs_;
+
+  template <class Sequence>
+  void compute(const std::vector<Sequence>& alignment);
+  void checkPairs(const char *method) const;
+
+  /// \cond
+  template <class Result, class Function>
+  struct Replicates {
+    const SitePatterns& patterns;
+    boost::uint64_t seed;
+    Function f;
+    std::vector<Result>& results;
+    unsigned first, step;
+
+    Replicates(const SitePatterns& aPatterns, boost::uint64_t aSeed,
+	       Function anF, std::vector<Result>& theResults,
+	       unsigned aFirst, unsigned aStep)
+      : patterns(aPatterns), seed(aSeed), f(anF), results(theResults),
+	first(aFirst), step(aStep) { }
+
+    void operator() () {
+      Weights weights;
+
+      for (unsigned r = first; r < results.size(); r += step) {
+	Random random(seed, r);
+	patterns.resample(random, weights);
+	results[r] = f(weights);
+      }
+    }
+  };
+  /// \endcond
+};
+
+template <class Result, class Function>
+void SitePatterns::bootstrap(unsigned replicates, boost::uint64_t seed,
+			     Function f, std::vector<Result>& results,
+			     int threads) const
+{
+  results.resize(replicates);
+
+  if (threads < 1)
+    threads = 1;
+
+  boost::thread_group group;
+  for (int t = 1; t < threads; ++t)
+    group.create_thread(Replicates<Result, Function>(*this, seed, f, results,
+						     t, threads));
+
+  Replicates<Result, Function>(*this, seed, f, results, 0, threads)();
+
+  group.join_all();
+}
+
+};
+
+#endif // SITE_PATTERNS_H_
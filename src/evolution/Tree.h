@@ -0,0 +1,109 @@
+// This may look like C code, but it's really -*- C++ -*-
+#ifndef TREE_H_
+#define TREE_H_
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace seq {
+
+/**
+ * A phylogenetic tree with branch lengths.
+ *
+ * Nodes are identified by their index, in the order in which they
+ * were added. Every node has a name (usually only the leaves), the
+ * length of the branch to its parent, and any number of children. An
+ * unrooted tree is represented with a root node with three children.
+ *
+ * \sa NeighborJoining
+ */
+class Tree
+{
+public:
+  /**
+   * A node of the tree.
+   */
+  struct Node {
+    std::string      name;
+    double           length;   //!< length of the branch to the parent
+    int              parent;   //!< -1 for the root
+    std::vector<int> children;
+
+    Node(const std::string& aName)
+      : name(aName), length(0), parent(-1) { }
+  };
+
+  /**
+   * Create an empty tree.
+   */
+  Tree();
+
+  /**
+   * Add a node without parent and children, returning its index.
+   */
+  int addNode(const std::string& name = std::string());
+
+  /**
+   * Make a node a child of another node, with the given branch length.
+   */
+  void addChild(int parent, int child, double length);
+
+  /**
+   * Set the root node.
+   *
+   * When not set, the root is the last node without parent.
+   */
+  void setRoot(int node) { root_ = node; }
+
+  /**
+   * Get the root node (-1 if the tree is empty).
+   */
+  int root() const;
+
+  /**
+   * Get the number of nodes.
+   */
+  unsigned size() const { return nodes_.size(); }
+
+  /**
+   * Get a node.
+   */
+  const Node& node(int i) const { return nodes_[i]; }
+
+  /**
+   * Get the number of leaves.
+   */
+  unsigned leafCount() const;
+
+  /**
+   * Write the tree in Newick format (e.g. "(A:0.1,B:0.2,(C:0.3,D:0.4):0.5);").
+   *
+   * Names with special characters are quoted. The branch lengths are
+   * written with the precision of the stream. The tree is traversed
+   * without recursion, so that deep trees may be written.
+   */
+  void writeNewick(std::ostream& o) const;
+
+  /**
+   * Get the Newick representation.
+   *
+   * \sa writeNewick()
+   */
+  std::string newick() const;
+
+private:
+  std::vector<Node> nodes_;
+  int root_;
+};
+
+/**
+ * Write the tree in Newick format.
+ *
+ * \sa Tree::writeNewick()
+ */
+extern std::ostream& operator<< (std::ostream& o, const Tree& tree);
+
+};
+
+#endif // TREE_H_
@@ -8,6 +8,7 @@
 
 #include "NTSequence.h"
 #include "AminoAcid.h"
+#include "SequenceView.h"
 
 namespace seq {
 
@@ -42,9 +43,9 @@ public:
    * string will be interpreted as an AminoAcid using the
    * AminoAcid::AminoAcid(char) constructor.
    */
-  AASequence(const std::string name,
-	     const std::string description,
-	     const std::string aSeqString)
+  AASequence(const std::string& name,
+	     const std::string& description,
+	     const std::string& aSeqString)
     throw (ParseException);
 
   /**
@@ -61,22 +62,24 @@ public:
   /**
    * Get the name.
    */
-  std::string name() const { return name_; }
+  const std::string& name() const { return name_; }
 
   /**
    * Get the description.
    */
-  std::string description() const { return description_; }
+  const std::string& description() const { return description_; }
 
   /**
    * Set the name.
    */
-  void setName(std::string name) { name_ = name; }
+  void setName(const std::string& name) { name_ = name; }
 
   /**
    * Set the description.
    */
-  void setDescription(std::string description) { description_ = description; }
+  void setDescription(const std::string& description) {
+    description_ = description;
+  }
 
   /**
    * Translate a nucleotide sequence to an amino acid sequence. The
@@ -105,6 +108,21 @@ public:
    */
   static AASequence translate(const NTSequence::const_iterator begin,
 			      const NTSequence::const_iterator end);
+
+  /**
+   * Translate a view on a nucleotide sequence, which must have a
+   * length that is a multiple of three, to an amino acid sequence with
+   * an empty name and empty description.
+   *
+   * \sa translate(const NTSequenceView&, AASequence&)
+   */
+  static AASequence translate(const NTSequenceView& ntSequence);
+
+  /**
+   * Translate a view on a nucleotide sequence into result, reusing its
+   * memory. The name and description of result are not changed.
+   */
+  static void translate(const NTSequenceView& ntSequence, AASequence& result);
 private:
   std::string name_;
   std::string description_;
@@ -0,0 +1,126 @@
+// This may look like C code, but it's really -*- C++ -*-
+#ifndef BOUNDED_QUEUE_H_
+#define BOUNDED_QUEUE_H_
+
+#include <deque>
+#include <boost/thread.hpp>
+
+namespace seq {
+
+/**
+ * A first-in first-out queue with a limited capacity, to pass work
+ * between threads.
+ *
+ * push() blocks while the queue is full, and pop() blocks while the
+ * queue is empty, so that a fast producer is held back by a slow
+ * consumer (backpressure) and the memory used by the queue is
+ * bounded.
+ *
+ * After close(), push() fails and pop() fails once the remaining
+ * items have been taken, which is how a producer signals the end of
+ * its work to the consumers.
+ */
+template <typename T>
+class BoundedQueue
+{
+public:
+  /**
+   * Create an empty queue for at most capacity items.
+   */
+  BoundedQueue(unsigned capacity)
+    : capacity_(capacity ? capacity : 1),
+      closed_(false) { }
+
+  /**
+   * Get the maximum number of items.
+   */
+  unsigned capacity() const { return capacity_; }
+
+  /**
+   * Get the current number of items.
+   */
+  unsigned size() const {
+    boost::mutex::scoped_lock lock(mutex_);
+    return items_.size();
+  }
+
+  /**
+   * Add an item, waiting while the queue is full.
+   *
+   * Returns false (without adding the item) if the queue is closed.
+   */
+  bool push(const T& item) {
+    {
+      boost::mutex::scoped_lock lock(mutex_);
+
+      while (items_.size() >= capacity_ && !closed_)
+	notFull_.wait(lock);
+
+      if (closed_)
+	return false;
+
+      items_.push_back(item);
+    }
+
+    notEmpty_.notify_one();
+    return true;
+  }
+
+  /**
+   * Take the oldest item, waiting while the queue is empty.
+   *
+   * Returns false if the queue is closed and empty.
+   */
+  bool pop(T& item) {
+    {
+      boost::mutex::scoped_lock lock(mutex_);
+
+      while (items_.empty() && !closed_)
+	notEmpty_.wait(lock);
+
+      if (items_.empty())
+	return false;
+
+      item = items_.front();
+      items_.pop_front();
+    }
+
+    notFull_.notify_one();
+    return true;
+  }
+
+  /**
+   * Close the queue, waking up all waiting threads.
+   */
+  void close() {
+    {
+      boost::mutex::scoped_lock lock(mutex_);
+      closed_ = true;
+    }
+
+    notEmpty_.notify_all();
+    notFull_.notify_all();
+  }
+
+  /**
+   * Return whether the queue is closed.
+   */
+  bool closed() const {
+    boost::mutex::scoped_lock lock(mutex_);
+    return closed_;
+  }
+
+private:
+  std::deque<T>             items_;
+  unsigned                  capacity_;
+  bool                      closed_;
+  mutable boost::mutex      mutex_;
+  boost::condition_variable notEmpty_, notFull_;
+
+  BoundedQueue(const BoundedQueue&);
+  BoundedQueue& operator=(const BoundedQueue&);
+};
+
+};
+
+#endif // BOUNDED_QUEUE_H_
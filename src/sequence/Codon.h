@@ -27,9 +27,36 @@ public:
    */
   static AminoAcid translate(const NTSequence::const_iterator triplet);
 
+  /**
+   * Translate a nucleotide triplet, given by its three nucleotides.
+   *
+   * \sa translate(const NTSequence::const_iterator)
+   */
+  static AminoAcid translate(Nucleotide n1, Nucleotide n2, Nucleotide n3);
+
+  /**
+   * Get all the amino acids possibly represented by a nucleotide
+   * triplet that may contain ambiguity codes.
+   *
+   * \sa translateAllMask()
+   */
   static std::set<AminoAcid>
      translateAll(const NTSequence::const_iterator triplet);
 
+  /**
+   * Like translateAll(), but returns the amino acids as a bit mask,
+   * where bit i is set for the amino acid with internal representation
+   * i. This does not allocate memory.
+   */
+  static unsigned translateAllMask(const NTSequence::const_iterator triplet);
+
+  /**
+   * Like translateAllMask(), for a triplet given by its three
+   * nucleotides.
+   */
+  static unsigned translateAllMask(Nucleotide n1, Nucleotide n2,
+				   Nucleotide n3);
+
   static std::set<NTSequence> codonsFor(AminoAcid a);
 };
 
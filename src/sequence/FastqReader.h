@@ -0,0 +1,113 @@
+// This may look like C code, but it's really -*- C++ -*-
+#ifndef FASTQ_READER_H_
+#define FASTQ_READER_H_
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "ParseException.h"
+#include "NTSequence.h"
+
+namespace seq {
+
+/**
+ * Phred quality scores of the nucleotides of a sequence, one byte
+ * per nucleotide.
+ */
+typedef std::vector<unsigned char> QualityScores;
+
+/**
+ * A streaming reader for FASTQ files.
+ *
+ * Every record consists of four lines: a header line starting with
+ * '@' (with the sequence name and optional description), the
+ * sequence, a separator line starting with '+', and the qualities
+ * (one character per nucleotide). The reader reuses its line buffers,
+ * so reading a file does not allocate memory per record, other than
+ * for the resulting sequence.
+ *
+ * Optionally, reads are quality trimmed and low quality nucleotides
+ * are masked while parsing:
+ *  - trimming removes the low quality ends of a read: at the 3' end
+ *    using the algorithm of BWA (the suffix that maximizes the sum of
+ *    (trimQuality - quality) is removed), and at the 5' end the
+ *    leading nucleotides with a quality below trimQuality.
+ *  - masking replaces every remaining nucleotide with a quality below
+ *    maskQuality by Nucleotide::N.
+ *
+ * The resulting sequences may be used directly with the alignment and
+ * translation algorithms.
+ */
+class FastqReader
+{
+public:
+  /**
+   * Create a reader for the given stream.
+   *
+   * The quality characters are decoded using qualityOffset (33 for
+   * Sanger / Illumina 1.8+, 64 for older Illumina files).
+   */
+  FastqReader(std::istream& input, int qualityOffset = 33);
+
+  /**
+   * Set the quality threshold for trimming the read ends (0 disables
+   * trimming, which is the default).
+   */
+  void setTrimQuality(int quality) { trimQuality_ = quality; }
+
+  /**
+   * Set the quality threshold for masking nucleotides with N (0
+   * disables masking, which is the default).
+   */
+  void setMaskQuality(int quality) { maskQuality_ = quality; }
+
+  /**
+   * Read the next record.
+   *
+   * Returns false at the end of the input. The qualities of the
+   * (trimmed) sequence are stored in qualities. When a record cannot
+   * be parsed, a ParseException is thrown; the reader then skips to
+   * the next record (the exception is recovered()) unless the input
+   * ended.
+   */
+  bool read(NTSequence& sequence, QualityScores& qualities)
+    throw (ParseException);
+
+  /**
+   * Read the next record, ignoring the qualities.
+   */
+  bool read(NTSequence& sequence) throw (ParseException);
+
+  /**
+   * Get the number of records read so far.
+   */
+  unsigned long long recordCount() const { return records_; }
+
+  /**
+   * Get the total number of nucleotides that were trimmed so far.
+   */
+  unsigned long long trimmedCount() const { return trimmed_; }
+
+  /**
+   * Get the total number of nucleotides that were masked so far.
+   */
+  unsigned long long maskedCount() const { return masked_; }
+
+private:
+  std::istream& input_;
+  int qualityOffset_;
+  int trimQuality_;
+  int maskQuality_;
+  unsigned long long records_, trimmed_, masked_;
+
+  std::string header_, sequence_, separator_, quality_;
+  QualityScores qualities_;
+
+  void trim(const QualityScores& qualities, unsigned& begin, unsigned& end)
+    const;
+};
+
+};
+
+#endif // FASTQ_READER_H_
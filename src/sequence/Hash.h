@@ -0,0 +1,118 @@
+// This may look like C code, but it's really -*- C++ -*-
+#ifndef HASH_H_
+#define HASH_H_
+
+#include <cstring>
+#include <string>
+#include <boost/cstdint.hpp>
+
+namespace seq {
+
+/**
+ * A fast, non-cryptographic 64-bit hash function.
+ *
+ * Data is added incrementally (bytes, words, numbers, strings or
+ * sequences), and value() returns the hash of all data added so far.
+ * Hashes with a different seed are independent, so that combining the
+ * values of two seeds gives a 128-bit hash with a negligible chance of
+ * collisions.
+ *
+ * The hash value of given data is identical on every platform.
+ */
+class Hash
+{
+public:
+  /**
+   * Create a hash with given seed.
+   */
+  Hash(boost::uint64_t seed = 0)
+    : state_(mix(seed)),
+      pending_(0),
+      length_(0)
+  { }
+
+  /**
+   * Add a byte.
+   */
+  void add(unsigned char byte) {
+    pending_ |= (boost::uint64_t)byte << (8 * (length_ % 8));
+    if (++length_ % 8 == 0) {
+      addWord(pending_);
+      pending_ = 0;
+    }
+  }
+
+  /**
+   * Add a 64-bit word.
+   */
+  void add(boost::uint64_t word) {
+    for (unsigned i = 0; i < 8; ++i)
+      add((unsigned char)(word >> (8 * i)));
+  }
+
+  /**
+   * Add an integer.
+   */
+  void add(int value) {
+    add((boost::uint64_t)(boost::int64_t)value);
+  }
+
+  /**
+   * Add a floating point number.
+   */
+  void add(double value) {
+    boost::uint64_t word;
+    std::memcpy(&word, &value, sizeof(word));
+    add(word);
+  }
+
+  /**
+   * Add a string (including its length).
+   */
+  void add(const std::string& s) {
+    add((boost::uint64_t)s.length());
+    for (unsigned i = 0; i < s.length(); ++i)
+      add((unsigned char)s[i]);
+  }
+
+  /**
+   * Add the symbols of a sequence (NTSequence or AASequence),
+   * excluding its name and description.
+   */
+  template <class Symbols>
+  void addSymbols(const Symbols& symbols) {
+    add((boost::uint64_t)symbols.size());
+    for (unsigned i = 0; i < symbols.size(); ++i)
+      add((unsigned char)symbols[i].intRep());
+  }
+
+  /**
+   * Get the hash value.
+   */
+  boost::uint64_t value() const {
+    return mix((length_ % 8 ? step(state_, pending_) : state_) ^ length_);
+  }
+
+private:
+  boost::uint64_t state_, pending_, length_;
+
+  void addWord(boost::uint64_t word) {
+    state_ = step(state_, word);
+  }
+
+  static boost::uint64_t step(boost::uint64_t state, boost::uint64_t word) {
+    state ^= word * 0x87C37B91114253D5ULL;
+    state = (state << 31) | (state >> 33);
+    return state * 0x4CF5AD432745937FULL + 0x52DCE729ULL;
+  }
+
+  static boost::uint64_t mix(boost::uint64_t z) {
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+  }
+};
+
+};
+
+#endif // HASH_H_
@@ -48,12 +48,23 @@ public:
    *
    * \sa sampleAmbiguities()
    */
-  NTSequence(const std::string name,
-	     const std::string description,
-	     const std::string aSeqString,
+  NTSequence(const std::string& name,
+	     const std::string& description,
+	     const std::string& aSeqString,
 	     bool sampleAmbiguities = false)
     throw (ParseException);
 
+  /**
+   * Create a nucleotide sequence with given name and description,
+   * like NTSequence(name, description, aSeqString), and perform
+   * sampleAmbiguities(Random&) with the given generator.
+   */
+  NTSequence(const std::string& name,
+	     const std::string& description,
+	     const std::string& aSeqString,
+	     Random& random)
+    throw (ParseException);
+
   /**
    * Create a nucleotide sequence with empty name and emtpy
    * description, and copy the sequence data from the range [first, last[.
@@ -66,18 +77,67 @@ public:
    * a random non-ambiguous nucleotide that is represented by the
    * ambiguity symbol.
    *
-   * \sa Nucleotide::sampleAmbiguity()
+   * This uses the global drand48() generator, and is therefore not
+   * thread-safe.
+   *
+   * \sa Nucleotide::sampleAmbiguity(), sampleAmbiguities(Random&)
    */
   void sampleAmbiguities();
 
+  /**
+   * Remove ambiguity nucleotide symbols by replacing them by sampling
+   * a random non-ambiguous nucleotide that is represented by the
+   * ambiguity symbol, drawn from the given generator.
+   *
+   * One random word is used for every four ambiguity symbols, so the
+   * result for a given generator state is reproducible, but differs
+   * from calling Nucleotide::sampleAmbiguity(Random&) for every
+   * nucleotide.
+   */
+  void sampleAmbiguities(Random& random);
+
+  /**
+   * Get the reverse complement of this sequence.
+   *
+   * \sa reverseComplementInPlace()
+   */
   NTSequence reverseComplement() const;
 
+  /**
+   * Replace this sequence by its reverse complement, without copying.
+   */
+  void reverseComplementInPlace();
+
   /**
    * Add all the possible non-ambiguous sequences possibly represented by
    * this sequence to result.
+   *
+   * \sa visitNonAmbiguousSequences(), nonAmbiguousSequenceCount()
    */
   void nonAmbiguousSequences(std::vector<NTSequence>& result) const;
 
+  /**
+   * Visit all the possible non-ambiguous sequences possibly
+   * represented by this sequence, without storing them.
+   *
+   * For every sequence s, visitor(s) is called, which returns whether
+   * the iteration should continue. The sequences are visited in the
+   * same order as returned by nonAmbiguousSequences(). The sequence
+   * passed to the visitor is only valid during the call.
+   *
+   * Returns false if the iteration was stopped by the visitor.
+   */
+  template <class Visitor>
+  bool visitNonAmbiguousSequences(Visitor& visitor) const;
+
+  /**
+   * Get the number of non-ambiguous sequences possibly represented by
+   * this sequence (gaps are not ambiguous), without enumerating them.
+   *
+   * The result is exact up to 2^53.
+   */
+  double nonAmbiguousSequenceCount() const;
+
   /**
    * Represent the sequence data as a string.
    */
@@ -86,31 +146,70 @@ public:
   /**
    * Get the name.
    */
-  std::string name() const { return name_; }
+  const std::string& name() const { return name_; }
 
   /**
    * Get the description.
    */
-  std::string description() const { return description_; }
+  const std::string& description() const { return description_; }
 
   /**
    * Set the name.
    */
-  void setName(std::string name) { name_ = name; }
+  void setName(const std::string& name) { name_ = name; }
 
   /**
    * Set the description.
    */
-  void setDescription(std::string description) { description_ = description; }
+  void setDescription(const std::string& description) {
+    description_ = description;
+  }
 
 private:
   std::string name_;
   std::string description_;
-
-  void iterateNonAmbiguous(const NTSequence& head,
-			   std::vector<NTSequence>& result) const;
 };
 
+template <class Visitor>
+bool NTSequence::visitNonAmbiguousSequences(Visitor& visitor) const
+{
+  /*
+   * The positions with an ambiguity symbol are enumerated like an
+   * odometer, with the last position changing fastest.
+   */
+  NTSequence s(begin(), end());
+  std::vector<unsigned> ambiguous;
+
+  for (unsigned i = 0; i < size(); ++i) {
+    if ((*this)[i].nonAmbiguousCount() > 1) {
+      const int mask = (*this)[i].mask();
+      ambiguous.push_back(i);
+      s[i] = Nucleotide::fromMask(mask & -mask);
+    }
+  }
+
+  for (;;) {
+    if (!visitor(static_cast<const NTSequence&>(s)))
+      return false;
+
+    int k = ambiguous.size() - 1;
+    for (; k >= 0; --k) {
+      const unsigned i = ambiguous[k];
+      const int mask = (*this)[i].mask();
+      const int next = mask & ~((s[i].mask() << 1) - 1);
+
+      if (next) {
+	s[i] = Nucleotide::fromMask(next & -next);
+	break;
+      } else
+	s[i] = Nucleotide::fromMask(mask & -mask);
+    }
+
+    if (k < 0)
+      return true;
+  }
+}
+
 /**
  * Write a set of sequences to Stockholm format
  */
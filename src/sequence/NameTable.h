@@ -0,0 +1,111 @@
+// This may look like C code, but it's really -*- C++ -*-
+#ifndef NAME_TABLE_H_
+#define NAME_TABLE_H_
+
+#include <string>
+#include <vector>
+#include <boost/cstdint.hpp>
+
+namespace seq {
+
+/**
+ * A table of interned strings, such as the names and descriptions of a
+ * large set of sequences.
+ *
+ * Every distinct string is stored once, in a single character arena,
+ * and is identified by a handle: its index in the table, in order of
+ * interning. The table has no per-string heap allocations, and finds
+ * the handle of a string with a single hash table probe (in the
+ * common case), so that it also serves as a name to index map for a
+ * collection of sequences with unique names:
+ *
+ * \code
+ * NameTable names;
+ * for (unsigned i = 0; i < sequences.size(); ++i)
+ *   if (names.intern(sequences[i].name()) != (int)i)
+ *     throw std::runtime_error("duplicate name " + sequences[i].name());
+ *
+ * int i = names.find("AB012345"); // -1 if not found
+ * \endcode
+ */
+class NameTable
+{
+public:
+  /**
+   * Create an empty table.
+   */
+  NameTable();
+
+  /**
+   * Get the number of distinct strings.
+   */
+  unsigned size() const { return offsets_.size() - 1; }
+
+  /**
+   * Get the handle of a string, adding it to the table if needed.
+   */
+  int intern(const std::string& s);
+
+  /**
+   * Get the handle of a string of the given length, adding it to the
+   * table if needed.
+   */
+  int intern(const char *s, unsigned length);
+
+  /**
+   * Get the handle of a string, or -1 if it is not in the table.
+   */
+  int find(const std::string& s) const;
+
+  /**
+   * Get the handle of a string of the given length, or -1 if it is not
+   * in the table.
+   */
+  int find(const char *s, unsigned length) const;
+
+  /**
+   * Get a string as a null-terminated character array.
+   *
+   * The pointer remains valid until the next call to intern().
+   */
+  const char *c_str(int handle) const { return &arena_[offsets_[handle]]; }
+
+  /**
+   * Get the length of a string.
+   */
+  unsigned length(int handle) const {
+    return offsets_[handle + 1] - offsets_[handle] - 1;
+  }
+
+  /**
+   * Get a copy of a string.
+   */
+  std::string str(int handle) const {
+    return std::string(c_str(handle), length(handle));
+  }
+
+  /**
+   * Remove all strings.
+   */
+  void clear();
+
+  /**
+   * Get the (approximate) number of bytes used by the table.
+   */
+  std::size_t memoryUsage() const;
+
+private:
+  std::vector<char>            arena_;   // the strings, null-terminated
+  std::vector<boost::uint64_t> offsets_; // of every string, and the end
+  std::vector<boost::uint32_t> hashes_;  // of every string
+  std::vector<int>             slots_;   // open addressing: handle or -1
+
+  static boost::uint32_t hash(const char *s, unsigned length);
+  int lookup(const char *s, unsigned length, boost::uint32_t h,
+	     unsigned& slot) const;
+  void rehash(unsigned slotCount);
+};
+
+};
+
+#endif // NAME_TABLE_H_
@@ -9,6 +9,7 @@
 #include <set>
 
 #include "ParseException.h"
+#include "Random.h"
 
 namespace seq {
   
@@ -138,11 +139,29 @@ public:
    * Replace the (ambiguos) nucleotide with a random non-ambigiuos nucleotide
    * that is represented by the ambiguity symbol.
    *
-   * \sa isAmbiguity()
+   * This uses the global drand48() generator, and is therefore not
+   * thread-safe.
+   *
+   * \sa isAmbiguity(), sampleAmbiguity(Random&)
    */
   void sampleAmbiguity();
 
-  Nucleotide reverseComplement() const;
+  /**
+   * Replace the (ambiguous) nucleotide with a random non-ambiguous
+   * nucleotide that is represented by the ambiguity symbol, drawn
+   * from the given generator.
+   *
+   * A gap is left unchanged.
+   */
+  void sampleAmbiguity(Random& random);
+
+  /**
+   * Get the complementary nucleotide (for ambiguity symbols, the
+   * symbol representing the complementary nucleotides).
+   */
+  Nucleotide reverseComplement() const {
+    return Nucleotide(NT_COMPLEMENT[rep_]);
+  }
 
   /**
    * Get all non ambiguous nucleotides represented by this nucleotide.
@@ -154,6 +173,59 @@ public:
    */
   static Nucleotide singleNucleotide(std::set<Nucleotide>& nucleotides);
 
+  /**
+   * @name Bit mask representation.
+   *
+   * A nucleotide represents a set of the non-ambiguous nucleotides,
+   * which is encoded in a 4-bit mask: A = 1, C = 2, G = 4 and T = 8.
+   * Thus, the mask of an ambiguity symbol is the bitwise or of the
+   * nucleotides it represents (e.g. R = A | G = 5, N = 15). A gap has
+   * an empty mask (0).
+   *
+   * Two nucleotides are compatible (may represent the same
+   * nucleotide) if the bitwise and of their masks is not 0.
+   */
+  //@{
+  static const int MASK_A = 1;
+  static const int MASK_C = 2;
+  static const int MASK_G = 4;
+  static const int MASK_T = 8;
+
+  /**
+   * Get the mask.
+   *
+   * \sa fromMask(int)
+   */
+  int mask() const {
+    return NT_MASK[rep_];
+  }
+
+  /**
+   * Create the nucleotide for a mask (0 - 15).
+   *
+   * \sa mask()
+   */
+  static Nucleotide fromMask(int mask) {
+    assert(mask >= 0 && mask <= 15);
+
+    return Nucleotide(MASK_NT[mask]);
+  }
+
+  /**
+   * Get the number of non-ambiguous nucleotides represented by this
+   * nucleotide (0 for a gap).
+   */
+  int nonAmbiguousCount() const {
+    return MASK_COUNT[NT_MASK[rep_]];
+  }
+
+  /**
+   * Get the i'th (0 <= i < nonAmbiguousCount()) non-ambiguous
+   * nucleotide represented by this nucleotide, in the order A, C, G, T.
+   */
+  Nucleotide nonAmbiguousNucleotide(int i) const;
+  //@}
+
   /**
    * So that you can use it as a key for STL containers.
    */
@@ -161,6 +233,10 @@ public:
 
 private:
   static const char NT_CHAR[];
+  static const int NT_MASK[];
+  static const int NT_COMPLEMENT[];
+  static const int MASK_NT[];
+  static const int MASK_COUNT[];
 
   Nucleotide(int rep)
     : rep_(rep) {
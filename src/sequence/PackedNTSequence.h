@@ -0,0 +1,115 @@
+// This may look like C code, but it's really -*- C++ -*-
+#ifndef PACKED_NTSEQUENCE_H_
+#define PACKED_NTSEQUENCE_H_
+
+#include <vector>
+#include <boost/cstdint.hpp>
+
+#include "NTSequence.h"
+
+namespace seq {
+
+/**
+ * A compact nucleotide sequence, storing the bit mask of every
+ * nucleotide (see Nucleotide::mask()) in 4 bits.
+ *
+ * Sixteen nucleotides are packed in a single 64-bit word, so that
+ * operations on ambiguities, such as intersecting two aligned
+ * sequences or counting incompatible sites, work on 16 sites at once.
+ *
+ * The name and description of the sequence are not kept.
+ */
+class PackedNTSequence
+{
+public:
+  /**
+   * Create an empty sequence.
+   */
+  PackedNTSequence();
+
+  /**
+   * Create a packed copy of a nucleotide sequence.
+   */
+  PackedNTSequence(const NTSequence& sequence);
+
+  /**
+   * Create a sequence of the given size from its packed words.
+   *
+   * \sa words()
+   */
+  PackedNTSequence(const std::vector<boost::uint64_t>& words, unsigned size);
+
+  /**
+   * Get the number of nucleotides.
+   */
+  unsigned size() const { return size_; }
+
+  /**
+   * Get the mask of the nucleotide at position i.
+   */
+  int mask(unsigned i) const {
+    return (words_[i / SITES_PER_WORD] >> (4 * (i % SITES_PER_WORD))) & 0xF;
+  }
+
+  /**
+   * Get the nucleotide at position i.
+   */
+  Nucleotide operator[](unsigned i) const {
+    return Nucleotide::fromMask(mask(i));
+  }
+
+  /**
+   * Set the nucleotide at position i.
+   */
+  void set(unsigned i, const Nucleotide nt);
+
+  /**
+   * Get the unpacked nucleotide sequence.
+   */
+  NTSequence unpack() const;
+
+  /**
+   * Intersect with another sequence of the same size: every
+   * nucleotide is replaced with the nucleotides it has in common with
+   * the nucleotide at the same position in other. Incompatible
+   * nucleotides become a gap.
+   *
+   * \sa countIncompatible()
+   */
+  void intersect(const PackedNTSequence& other);
+
+  /**
+   * Unite with another sequence of the same size: every nucleotide is
+   * replaced with the ambiguity code for the nucleotides represented by
+   * either this or the nucleotide at the same position in other.
+   */
+  void unite(const PackedNTSequence& other);
+
+  /**
+   * Count the positions at which this sequence and another sequence of
+   * the same size have nucleotides that cannot be the same. Positions
+   * where either sequence has a gap are not counted.
+   */
+  unsigned countIncompatible(const PackedNTSequence& other) const;
+
+  /**
+   * Get the packed words, where nucleotide i is stored in bits
+   * 4 * (i % 16) to 4 * (i % 16) + 3 of word i / 16.
+   */
+  const std::vector<boost::uint64_t>& words() const { return words_; }
+
+  /**
+   * The number of nucleotides per word.
+   */
+  static const unsigned SITES_PER_WORD = 16;
+
+private:
+  std::vector<boost::uint64_t> words_;
+  unsigned size_;
+
+  void checkSize(const PackedNTSequence& other, const char *method) const;
+};
+
+};
+
+#endif // PACKED_NTSEQUENCE_H_
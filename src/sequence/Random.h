@@ -0,0 +1,73 @@
+// This may look like C code, but it's really -*- C++ -*-
+#ifndef RANDOM_H_
+#define RANDOM_H_
+
+#include <boost/cstdint.hpp>
+
+namespace seq {
+
+/**
+ * A small and fast pseudo-random number generator (splitmix64).
+ *
+ * The generator is counter-based: its state is a 64-bit counter that
+ * is incremented for every number, and the number is a hash of the
+ * counter. This makes it cheap to create a generator per thread or per
+ * sequence, and the numbers generated for a given seed and stream are
+ * identical on every platform.
+ *
+ * A generator is not safe to share between threads; use a separate
+ * generator (e.g. with a different stream) in every thread instead.
+ */
+class Random
+{
+public:
+  /**
+   * Create a generator with given seed.
+   *
+   * Generators with the same seed but a different stream (e.g. the
+   * index of a sequence or a thread) generate unrelated numbers.
+   * Stream 0 generates the numbers of the plain seed.
+   */
+  Random(boost::uint64_t seed, boost::uint64_t stream = 0);
+
+  /**
+   * Get the next random 64-bit word.
+   */
+  boost::uint64_t next() {
+    return mix(state_ += GOLDEN_GAMMA);
+  }
+
+  /**
+   * Get a uniform random number in [0, 1[.
+   */
+  double uniform() {
+    return (next() >> 11) * (1.0 / 9007199254740992.0);
+  }
+
+  /**
+   * Get a uniform random integer in [0, n[.
+   */
+  unsigned uniform(unsigned n) {
+    return (unsigned)(uniform() * n);
+  }
+
+  /**
+   * Get the state (the counter).
+   */
+  boost::uint64_t state() const { return state_; }
+
+private:
+  static const boost::uint64_t GOLDEN_GAMMA = 0x9E3779B97F4A7C15ULL;
+
+  boost::uint64_t state_;
+
+  static boost::uint64_t mix(boost::uint64_t z) {
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+  }
+};
+
+};
+
+#endif // RANDOM_H_
@@ -0,0 +1,221 @@
+// This may look like C code, but it's really -*- C++ -*-
+#ifndef REFERENCE_COLLECTION_H_
+#define REFERENCE_COLLECTION_H_
+
+#include <iterator>
+#include <string>
+#include <vector>
+#include <boost/cstdint.hpp>
+
+#include "NTSequence.h"
+#include "NameTable.h"
+
+namespace seq {
+
+/**
+ * A compressed collection of nucleotide sequences that are similar to
+ * a reference sequence.
+ *
+ * Every sequence is stored as its differences with the reference: runs
+ * of substituted, deleted and inserted nucleotides, relative to a
+ * position in the reference. The differences of all sequences are
+ * encoded in a single byte buffer (variable length integers, and 4
+ * bits per nucleotide), and names and descriptions in a single string,
+ * so that a sequence that differs at a few sites from the reference
+ * takes a few tens of bytes, instead of 2 bytes per nucleotide plus two
+ * std::string objects for an NTSequence. Names and descriptions are
+ * interned in a NameTable, which also finds a sequence by name.
+ *
+ * Sequences are added either as a row of a multiple alignment with the
+ * reference (same length, see add(const NTSequence&)), or as a
+ * pair-wise alignment with the reference (see add(const NTSequence&,
+ * const NTSequence&)), e.g. computed with NeedlemanWunsh or
+ * CodonAlign. A sequence is decoded entirely, or only the region that
+ * aligns with part of the reference.
+ */
+class ReferenceCollection
+{
+public:
+  /**
+   * A difference between a sequence and the reference.
+   */
+  struct Edit {
+    enum Type {
+      Substitution, //!< length reference nucleotides are replaced
+      Deletion,     //!< length reference nucleotides are removed
+      Insertion     //!< length nucleotides are inserted
+    };
+
+    Type       type;
+    unsigned   position;    //!< the (first) reference position
+    unsigned   length;
+    NTSequence nucleotides; //!< the new nucleotides (not for a Deletion)
+  };
+
+  /**
+   * An input iterator that decodes the sequences of the collection, in
+   * order.
+   */
+  class const_iterator
+    : public std::iterator<std::input_iterator_tag, NTSequence>
+  {
+  public:
+    const_iterator()
+      : collection_(0), i_(0), decoded_(false) { }
+
+    const NTSequence& operator*() const;
+    const NTSequence *operator->() const { return &**this; }
+
+    const_iterator& operator++() {
+      ++i_;
+      decoded_ = false;
+      return *this;
+    }
+
+    bool operator== (const const_iterator& other) const {
+      return i_ == other.i_;
+    }
+
+    bool operator!= (const const_iterator& other) const {
+      return i_ != other.i_;
+    }
+
+  private:
+    const ReferenceCollection *collection_;
+    unsigned                   i_;
+    mutable bool               decoded_;
+    mutable NTSequence         sequence_;
+
+    const_iterator(const ReferenceCollection *collection, unsigned i)
+      : collection_(collection), i_(i), decoded_(false) { }
+
+    friend class ReferenceCollection;
+  };
+
+  /**
+   * Create an empty collection for the given reference sequence.
+   */
+  ReferenceCollection(const NTSequence& reference);
+
+  /**
+   * Get the reference sequence.
+   */
+  const NTSequence& reference() const { return reference_; }
+
+  /**
+   * Get the number of sequences.
+   */
+  unsigned size() const { return offsets_.size() - 1; }
+
+  /**
+   * Add a sequence that is aligned with the reference in a multiple
+   * alignment: it has the same length as the reference, and every
+   * position that differs is stored as a substitution.
+   *
+   * Throws a std::runtime_error if the sequence has a different
+   * length than the reference.
+   */
+  void add(const NTSequence& sequence);
+
+  /**
+   * Add a sequence from its pair-wise alignment with the reference.
+   *
+   * The aligned reference, with gaps removed, must be the reference.
+   * Columns with a gap in the reference are insertions, and columns
+   * with a gap in the sequence are deletions. The sequence is stored
+   * without its alignment gaps, together with the name and description
+   * of the aligned sequence.
+   *
+   * Throws a std::runtime_error if the alignment does not match the
+   * reference.
+   */
+  void add(const NTSequence& alignedReference,
+	   const NTSequence& alignedSequence);
+
+  /**
+   * Decode sequence i.
+   */
+  NTSequence sequence(unsigned i) const;
+
+  /**
+   * Decode the region of sequence i that aligns with the reference
+   * positions [from, to[.
+   *
+   * Nucleotides inserted before a reference position p are part of the
+   * region if from <= p < to, and nucleotides inserted at the end of
+   * the reference if to is the reference length.
+   */
+  NTSequence sequence(unsigned i, unsigned from, unsigned to) const;
+
+  /**
+   * Decode sequence i into result, reusing its memory.
+   */
+  void decode(unsigned i, NTSequence& result) const;
+
+  /**
+   * Get the name of sequence i.
+   */
+  std::string name(unsigned i) const;
+
+  /**
+   * Get the description of sequence i.
+   */
+  std::string description(unsigned i) const;
+
+  /**
+   * Find the (first) sequence with the given name, or return -1.
+   */
+  int find(const std::string& name) const;
+
+  /**
+   * Get the differences between sequence i and the reference, in
+   * order of reference position.
+   */
+  void edits(unsigned i, std::vector<Edit>& result) const;
+
+  /**
+   * Get the number of reference positions at which sequence i has a
+   * different nucleotide (substitutions), without decoding it.
+   */
+  unsigned mismatches(unsigned i) const;
+
+  /**
+   * Add the substitutions of all sequences per reference position to
+   * counts (which is resized to the reference length if needed),
+   * without decoding them.
+   */
+  void mismatchProfile(std::vector<unsigned>& counts) const;
+
+  /**
+   * Get an iterator to the first sequence.
+   */
+  const_iterator begin() const { return const_iterator(this, 0); }
+
+  /**
+   * Get an iterator past the last sequence.
+   */
+  const_iterator end() const { return const_iterator(this, size()); }
+
+  /**
+   * Get the (approximate) number of bytes used by the collection.
+   */
+  std::size_t memoryUsage() const;
+
+private:
+  NTSequence                   reference_;
+  std::vector<unsigned char>   edits_;
+  std::vector<boost::uint64_t> offsets_;     // of every sequence in edits_
+  NameTable                    text_;        // names and descriptions
+  std::vector<int>             textHandles_; // name and description
+  std::vector<int>             nameIndex_;   // first sequence of a handle
+
+  void addEdit(Edit::Type type, unsigned position, unsigned length,
+	       unsigned& last, const Nucleotide *nucleotides);
+  void addText(const NTSequence& sequence);
+  void decode(unsigned i, unsigned from, unsigned to, NTSequence& result)
+    const;
+};
+
+};
+
+#endif // REFERENCE_COLLECTION_H_
@@ -0,0 +1,81 @@
+// This may look like C code, but it's really -*- C++ -*-
+#ifndef SEQUENCE_FILE_STREAM_H_
+#define SEQUENCE_FILE_STREAM_H_
+
+#include <istream>
+#include <string>
+
+namespace seq {
+
+/**
+ * An input file stream that transparently decompresses gzip (and,
+ * when available, zstd) compressed files.
+ *
+ * The compression is detected from the first bytes of the file, so
+ * that the stream may be used in place of a std::ifstream with all
+ * sequence readers (e.g. operator>>(std::istream&, NTSequence&) or
+ * FastqReader), regardless of the compression of the file.
+ *
+ * The file is read and decompressed by a background thread into a
+ * ring of large buffers, which are consumed by the stream. Thus
+ * decompression and parsing overlap.
+ *
+ * When the file cannot be opened, the failbit is set, as with a
+ * std::ifstream. When the (compressed) data is corrupt, or it uses a
+ * compression that is not supported, reading from the stream throws a
+ * ParseException.
+ */
+class SequenceFileStream : public std::istream
+{
+public:
+  /**
+   * The compression of a file.
+   */
+  enum Compression {
+    Uncompressed,
+    Gzip,
+    Zstd
+  };
+
+  /**
+   * Open a file.
+   *
+   * The data is decompressed in bufferCount buffers of bufferSize
+   * bytes.
+   */
+  SequenceFileStream(const std::string& fileName,
+		     unsigned bufferSize = 1 << 20,
+		     unsigned bufferCount = 4);
+
+  /**
+   * Close the file, stopping the background thread.
+   */
+  ~SequenceFileStream();
+
+  /**
+   * Get the detected compression of the file.
+   */
+  Compression compression() const;
+
+  /**
+   * Whether a compression is supported by this build of the library.
+   *
+   * Gzip is always supported, zstd only when libzstd was found while
+   * building the library.
+   */
+  static bool isSupported(Compression compression);
+
+  /// \cond
+  class Buffer;
+  /// \endcond
+
+private:
+  Buffer *buffer_;
+
+  SequenceFileStream(const SequenceFileStream&);
+  SequenceFileStream& operator=(const SequenceFileStream&);
+};
+
+};
+
+#endif // SEQUENCE_FILE_STREAM_H_
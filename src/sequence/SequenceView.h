@@ -0,0 +1,283 @@
+// This may look like C code, but it's really -*- C++ -*-
+#ifndef SEQUENCE_VIEW_H_
+#define SEQUENCE_VIEW_H_
+
+#include <cassert>
+#include <cstddef>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include "Nucleotide.h"
+#include "AminoAcid.h"
+
+namespace seq {
+
+/**
+ * A read-only view on (a region of) a sequence, which does not own or
+ * copy the symbols.
+ *
+ * A view is a pointer to the first symbol, a length and a stride: the
+ * distance between consecutive symbols of the view in the underlying
+ * sequence. A stride of -1 views a region in reverse order, and a
+ * stride of 3 e.g. the first positions of the codons of a coding
+ * sequence.
+ *
+ * A view is created implicitly from an NTSequence or an AASequence, so
+ * that functions that accept a view also accept a sequence. Views are
+ * meant to be passed by value or const reference and are cheap to
+ * copy. A view is invalidated by any operation that invalidates the
+ * iterators of the underlying sequence.
+ *
+ * \sa NTSequenceView, AASequenceView
+ */
+template <class Symbol>
+class SequenceView
+{
+public:
+  typedef Symbol value_type;
+  typedef const Symbol& reference;
+  typedef const Symbol& const_reference;
+  typedef std::ptrdiff_t difference_type;
+  typedef unsigned size_type;
+
+  /**
+   * A random access iterator over the symbols of a view.
+   */
+  class const_iterator
+    : public std::iterator<std::random_access_iterator_tag, Symbol,
+			   std::ptrdiff_t, const Symbol *, const Symbol&>
+  {
+  public:
+    const_iterator() : p_(0), stride_(1) { }
+
+    const Symbol& operator*() const { return *p_; }
+    const Symbol *operator->() const { return p_; }
+    const Symbol& operator[](std::ptrdiff_t n) const {
+      return p_[n * stride_];
+    }
+
+    const_iterator& operator++() { p_ += stride_; return *this; }
+    const_iterator& operator--() { p_ -= stride_; return *this; }
+
+    const_iterator operator++(int) {
+      const_iterator result = *this;
+      p_ += stride_;
+      return result;
+    }
+
+    const_iterator operator--(int) {
+      const_iterator result = *this;
+      p_ -= stride_;
+      return result;
+    }
+
+    const_iterator& operator+=(std::ptrdiff_t n) {
+      p_ += n * stride_;
+      return *this;
+    }
+
+    const_iterator& operator-=(std::ptrdiff_t n) {
+      p_ -= n * stride_;
+      return *this;
+    }
+
+    const_iterator operator+(std::ptrdiff_t n) const {
+      return const_iterator(p_ + n * stride_, stride_);
+    }
+
+    const_iterator operator-(std::ptrdiff_t n) const {
+      return const_iterator(p_ - n * stride_, stride_);
+    }
+
+    std::ptrdiff_t operator-(const const_iterator& other) const {
+      return (p_ - other.p_) / stride_;
+    }
+
+    bool operator==(const const_iterator& other) const {
+      return p_ == other.p_;
+    }
+
+    bool operator!=(const const_iterator& other) const {
+      return p_ != other.p_;
+    }
+
+    bool operator<(const const_iterator& other) const {
+      return (*this - other) < 0;
+    }
+
+    bool operator>(const const_iterator& other) const {
+      return other < *this;
+    }
+
+    bool operator<=(const const_iterator& other) const {
+      return !(other < *this);
+    }
+
+    bool operator>=(const const_iterator& other) const {
+      return !(*this < other);
+    }
+
+  private:
+    const Symbol *p_;
+    int stride_;
+
+    const_iterator(const Symbol *p, int stride) : p_(p), stride_(stride) { }
+
+    friend class SequenceView<Symbol>;
+  };
+
+  /**
+   * Create an empty view.
+   */
+  SequenceView()
+    : data_(0), size_(0), stride_(1) { }
+
+  /**
+   * Create a view on an entire sequence.
+   */
+  SequenceView(const std::vector<Symbol>& sequence)
+    : data_(sequence.empty() ? 0 : &sequence[0]),
+      size_(sequence.size()),
+      stride_(1) { }
+
+  /**
+   * Create a view on the region [from, to[ of a sequence.
+   */
+  SequenceView(const std::vector<Symbol>& sequence, unsigned from, unsigned to)
+    : data_(from < to ? &sequence[from] : 0),
+      size_(from < to ? to - from : 0),
+      stride_(1)
+  {
+    assert(from >= to || to <= sequence.size());
+  }
+
+  /**
+   * Create a view on size symbols, starting at first, and separated by
+   * stride symbols.
+   */
+  SequenceView(const Symbol *first, unsigned size, int stride = 1)
+    : data_(size ? first : 0), size_(size), stride_(stride) { }
+
+  /**
+   * Get the length of the view.
+   */
+  unsigned size() const { return size_; }
+
+  /**
+   * Return whether the view is empty.
+   */
+  bool empty() const { return size_ == 0; }
+
+  /**
+   * Get the stride.
+   */
+  int stride() const { return stride_; }
+
+  /**
+   * Get symbol i of the view.
+   */
+  const Symbol& operator[](unsigned i) const {
+    return data_[(std::ptrdiff_t)i * stride_];
+  }
+
+  /**
+   * Get the first symbol of the view.
+   */
+  const Symbol& front() const { return data_[0]; }
+
+  /**
+   * Get the last symbol of the view.
+   */
+  const Symbol& back() const {
+    return data_[(std::ptrdiff_t)(size_ - 1) * stride_];
+  }
+
+  /**
+   * Get an iterator to the first symbol.
+   */
+  const_iterator begin() const { return const_iterator(data_, stride_); }
+
+  /**
+   * Get an iterator past the last symbol.
+   */
+  const_iterator end() const {
+    return const_iterator(data_ + (std::ptrdiff_t)size_ * stride_, stride_);
+  }
+
+  /**
+   * Get a view on the region [from, to[ of this view.
+   */
+  SequenceView sub(unsigned from, unsigned to) const {
+    assert(from >= to || to <= size_);
+    if (from >= to)
+      return SequenceView();
+
+    return SequenceView(data_ + (std::ptrdiff_t)from * stride_, to - from,
+			stride_);
+  }
+
+  /**
+   * Get a view on the symbols of this view in reverse order.
+   */
+  SequenceView reversed() const {
+    return size_ ? SequenceView(&back(), size_, -stride_) : SequenceView();
+  }
+
+  /**
+   * Copy the symbols to a sequence (such as an NTSequence or an
+   * AASequence).
+   */
+  template <class Sequence>
+  void copyTo(Sequence& result) const {
+    result.assign(begin(), end());
+  }
+
+  /**
+   * Represent the symbols as a string.
+   */
+  std::string asString() const {
+    std::string result(size_, '-');
+    for (unsigned i = 0; i < size_; ++i)
+      result[i] = (*this)[i].toChar();
+
+    return result;
+  }
+
+  /**
+   * Compare the symbols with those of another view.
+   */
+  bool operator==(const SequenceView& other) const {
+    if (size_ != other.size_)
+      return false;
+
+    for (unsigned i = 0; i < size_; ++i)
+      if ((*this)[i] != other[i])
+	return false;
+
+    return true;
+  }
+
+  bool operator!=(const SequenceView& other) const {
+    return !(*this == other);
+  }
+
+private:
+  const Symbol *data_;
+  unsigned      size_;
+  int           stride_;
+};
+
+/**
+ * A view on a nucleotide sequence.
+ */
+typedef SequenceView<Nucleotide> NTSequenceView;
+
+/**
+ * A view on an amino acid sequence.
+ */
+typedef SequenceView<AminoAcid> AASequenceView;
+
+};
+
+#endif // SEQUENCE_VIEW_H_
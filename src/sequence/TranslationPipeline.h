@@ -0,0 +1,107 @@
+// This may look like C code, but it's really -*- C++ -*-
+#ifndef TRANSLATION_PIPELINE_H_
+#define TRANSLATION_PIPELINE_H_
+
+#include <iostream>
+#include <string>
+
+#include "ParseException.h"
+
+namespace seq {
+
+/**
+ * Translates a FASTA stream of nucleotide sequences into a FASTA
+ * stream of amino acid sequences, using several threads.
+ *
+ * The work is split in three stages, which overlap:
+ *  - a reader thread parses the nucleotide sequences, and groups
+ *    them in batches;
+ *  - worker threads translate the batches, and format the amino acid
+ *    sequences as FASTA;
+ *  - the calling thread writes the batches, in the order of the
+ *    input.
+ *
+ * Every sequence is translated from its first nucleotide, up to its
+ * last complete codon, like AASequence::translate(), and keeps its
+ * name and (optionally prefixed) description.
+ *
+ * The stages are connected by BoundedQueue's, and the batches are
+ * recycled: at most maxBatches batches are in the pipeline at any
+ * time (being read, waiting, translated or written). Thus the reader
+ * waits when the workers or the writer cannot keep up, and the memory
+ * use is bounded regardless of the size of the input:
+ *
+ * \code
+ * SequenceFileStream in("archive.fasta.gz");
+ * TranslationPipeline pipeline;
+ * pipeline.run(in, std::cout);
+ * \endcode
+ */
+class TranslationPipeline
+{
+public:
+  /**
+   * Counts of the work done by run().
+   */
+  struct Statistics {
+    unsigned long sequences;
+    unsigned long nucleotides;
+    unsigned long batches;
+
+    Statistics();
+  };
+
+  /**
+   * Create a pipeline with the given number of translation threads
+   * (0: one per processor core).
+   */
+  TranslationPipeline(unsigned threads = 0);
+
+  /**
+   * Get the number of translation threads.
+   */
+  unsigned threads() const { return threads_; }
+
+  /**
+   * Set the size of a batch: a batch is complete when it has
+   * sequences sequences (default 256), or at least nucleotides
+   * nucleotides (default 1 M).
+   */
+  void setBatchSize(unsigned sequences, unsigned nucleotides = 1 << 20);
+
+  /**
+   * Set the maximum number of batches in the pipeline (0, the
+   * default: four per translation thread).
+   */
+  void setMaxBatches(unsigned batches) { maxBatches_ = batches; }
+
+  /**
+   * Set a prefix for the description of every amino acid sequence
+   * (default none).
+   */
+  void setDescriptionPrefix(const std::string& prefix) {
+    descriptionPrefix_ = prefix;
+  }
+
+  /**
+   * Translate all sequences of input, writing them to output.
+   *
+   * When the input cannot be parsed, the sequences before the error
+   * are written, and the ParseException is thrown.
+   *
+   * @throws ParseException when the input cannot be parsed.
+   * @throws std::runtime_error when the input is not readable (e.g. a
+   * file that could not be opened), or the output cannot be written.
+   */
+  Statistics run(std::istream& input, std::ostream& output);
+
+private:
+  unsigned    threads_;
+  unsigned    batchSequences_, batchNucleotides_;
+  unsigned    maxBatches_;
+  std::string descriptionPrefix_;
+};
+
+};
+
+#endif // TRANSLATION_PIPELINE_H_
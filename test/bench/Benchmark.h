@@ -0,0 +1,224 @@
+// This may look like C code, but it's really -*- C++ -*-
+#ifndef BENCHMARK_H_
+#define BENCHMARK_H_
+
+#include <algorithm>
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <stdlib.h>
+#include <string.h>
+#include <boost/chrono.hpp>
+#include <boost/cstdint.hpp>
+
+#ifndef _WIN32
+#include <sys/resource.h>
+#endif
+
+/**
+ * A minimal benchmark harness.
+ *
+ * Every benchmark case runs a functor a number of times, records the
+ * latency of every run and reports throughput and latency
+ * percentiles, as JSON (default) or CSV.
+ *
+ * The peak memory use is that of the whole process (it never
+ * decreases), and is thus reported once for the suite: as
+ * peak_memory_kb in the JSON report, or on std::cerr with --csv.
+ *
+ * Recognized command line options:
+ *  - --csv: report as CSV instead of JSON
+ *  - --seed=N: seed for the synthetic workload (default 42)
+ *  - --scale=F: multiply the number of iterations by F
+ *  - --filter=S: only run cases whose name contains S
+ */
+namespace bench {
+
+class Runner
+{
+public:
+  Runner(int argc, char **argv, const std::string& suite)
+    : suite_(suite),
+      csv_(false),
+      seed_(42),
+      scale_(1.0)
+  {
+    for (int i = 1; i < argc; ++i) {
+      std::string arg = argv[i];
+      if (arg == "--csv")
+	csv_ = true;
+      else if (arg.compare(0, 7, "--seed=") == 0)
+	seed_ = strtoull(arg.c_str() + 7, 0, 10);
+      else if (arg.compare(0, 8, "--scale=") == 0)
+	scale_ = atof(arg.c_str() + 8);
+      else if (arg.compare(0, 9, "--filter=") == 0)
+	filter_ = arg.substr(9);
+      else {
+	std::cerr << "Usage: " << argv[0]
+		  << " [--csv] [--seed=N] [--scale=F] [--filter=S]"
+		  << std::endl;
+	exit(1);
+      }
+    }
+  }
+
+  /**
+   * The seed for generating the workload.
+   */
+  boost::uint64_t seed() const { return seed_; }
+
+  /**
+   * Whether a case with the given name will run.
+   */
+  bool enabled(const std::string& name) const {
+    return filter_.empty() || name.find(filter_) != std::string::npos;
+  }
+
+  /**
+   * Run a benchmark case: call f() iterations times (scaled), after
+   * one warm-up call. Every call processes the given number of items
+   * and bytes.
+   */
+  template <class Function>
+  void run(const std::string& name, const std::string& parameters,
+	   Function& f, unsigned iterations,
+	   double itemsPerCall, double bytesPerCall)
+  {
+    if (!enabled(name))
+      return;
+
+    typedef boost::chrono::steady_clock Clock;
+
+    iterations = std::max(1u, (unsigned)(iterations * scale_));
+
+    f();
+
+    Result r;
+    r.name = name;
+    r.parameters = parameters;
+    r.iterations = iterations;
+    r.latencies.reserve(iterations);
+
+    for (unsigned i = 0; i < iterations; ++i) {
+      Clock::time_point start = Clock::now();
+      f();
+      Clock::time_point end = Clock::now();
+
+      r.latencies.push_back
+	(boost::chrono::duration<double>(end - start).count());
+    }
+
+    r.items = itemsPerCall * iterations;
+    r.bytes = bytesPerCall * iterations;
+
+    std::cerr << suite_ << "/" << name << " " << parameters << ": "
+	      << r.total() / iterations * 1000 << " ms/call" << std::endl;
+
+    results_.push_back(r);
+  }
+
+  /**
+   * Write the results of all cases.
+   */
+  void report(std::ostream& o) const
+  {
+    if (csv_) {
+      o << "suite,case,parameters,iterations,total_s,items_per_s,MB_per_s,"
+	"p50_ms,p90_ms,p99_ms,max_ms" << std::endl;
+      for (unsigned i = 0; i < results_.size(); ++i) {
+	const Result& r = results_[i];
+	o << suite_ << "," << r.name << ",\"" << r.parameters << "\","
+	  << r.iterations << "," << r.total() << ","
+	  << r.items / r.total() << "," << r.bytes / r.total() / 1E6 << ","
+	  << r.percentile(0.5) * 1000 << "," << r.percentile(0.9) * 1000 << ","
+	  << r.percentile(0.99) * 1000 << "," << r.percentile(1) * 1000
+	  << std::endl;
+      }
+
+      std::cerr << suite_ << ": peak memory " << peakMemoryKb() << " kB"
+		<< std::endl;
+    } else {
+      o << "{\"suite\":\"" << suite_ << "\",\"seed\":" << seed_
+	<< ",\"peak_memory_kb\":" << peakMemoryKb()
+	<< ",\"results\":[" << std::endl;
+      for (unsigned i = 0; i < results_.size(); ++i) {
+	const Result& r = results_[i];
+	o << " {\"case\":\"" << r.name << "\",\"parameters\":\""
+	  << r.parameters << "\",\"iterations\":" << r.iterations
+	  << ",\"total_s\":" << r.total()
+	  << ",\"items_per_s\":" << r.items / r.total()
+	  << ",\"MB_per_s\":" << r.bytes / r.total() / 1E6
+	  << ",\"latency_ms\":{\"p50\":" << r.percentile(0.5) * 1000
+	  << ",\"p90\":" << r.percentile(0.9) * 1000
+	  << ",\"p99\":" << r.percentile(0.99) * 1000
+	  << ",\"max\":" << r.percentile(1) * 1000
+	  << "}}"
+	  << (i + 1 < results_.size() ? "," : "") << std::endl;
+      }
+      o << "]}" << std::endl;
+    }
+  }
+
+  /**
+   * Peak resident memory of the process, in kB (-1 if unknown).
+   */
+  static long peakMemoryKb()
+  {
+#ifndef _WIN32
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) == 0)
+#ifdef __APPLE__
+      return usage.ru_maxrss / 1024;
+#else
+      return usage.ru_maxrss;
+#endif
+#endif
+    return -1;
+  }
+
+private:
+  struct Result {
+    std::string name, parameters;
+    unsigned iterations;
+    double items, bytes;
+    std::vector<double> latencies;
+
+    double total() const {
+      double result = 0;
+      for (unsigned i = 0; i < latencies.size(); ++i)
+	result += latencies[i];
+      return result;
+    }
+
+    double percentile(double p) const {
+      std::vector<double> sorted = latencies;
+      std::sort(sorted.begin(), sorted.end());
+      unsigned i = (unsigned)(p * (sorted.size() - 1) + 0.5);
+      return sorted[i];
+    }
+  };
+
+  std::string suite_;
+  bool csv_;
+  boost::uint64_t seed_;
+  double scale_;
+  std::string filter_;
+  std::vector<Result> results_;
+};
+
+/**
+ * Format parameters as "key=value" pairs.
+ */
+template <typename T>
+std::string param(const std::string& key, T value)
+{
+  std::ostringstream s;
+  s << key << "=" << value;
+  return s.str();
+}
+
+};
+
+#endif // BENCHMARK_H_
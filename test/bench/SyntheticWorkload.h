@@ -0,0 +1,104 @@
+// This may look like C code, but it's really -*- C++ -*-
+#ifndef SYNTHETIC_WORKLOAD_H_
+#define SYNTHETIC_WORKLOAD_H_
+
+#include <vector>
+#include <boost/cstdint.hpp>
+
+#include "NTSequence.h"
+#include "AASequence.h"
+#include "NucleotideSubstitutionModel.h"
+#include "Random.h"
+
+namespace seq {
+
+/**
+ * Deterministic generator of synthetic sequence data for benchmarks.
+ *
+ * Random coding sequences are evolved using the substitution rates of
+ * a NucleotideSubstitutionModel, with optional in-frame indels,
+ * frameshifts and ambiguity symbols. The same seed always generates
+ * the same data, on every platform.
+ */
+class SyntheticWorkload
+{
+public:
+  /**
+   * Create a generator with given seed, using the given substitution
+   * model for evolving sequences.
+   */
+  SyntheticWorkload(boost::uint64_t seed,
+		    const NucleotideSubstitutionModel& model);
+
+  /**
+   * Create a generator with given seed, and a HKY-like substitution
+   * model with a transition/transversion ratio of 4.
+   */
+  SyntheticWorkload(boost::uint64_t seed);
+
+  /**
+   * A random open reading frame of the given number of codons,
+   * starting with ATG and without stop codons.
+   */
+  NTSequence codingSequence(unsigned codons);
+
+  /**
+   * A random (ungapped) protein sequence of the given length.
+   */
+  AASequence protein(unsigned length);
+
+  /**
+   * Evolve a sequence.
+   *
+   * The result differs from the original sequence with on average
+   * divergence substitutions per site, distributed according to
+   * the substitution model. In addition, in-frame insertions and
+   * deletions of 1 to 3 codons occur at a rate of indelRate per codon,
+   * and exactly frameShifts frameshifts (insertion or deletion of 1
+   * or 2 nucleotides) are introduced.
+   */
+  NTSequence evolve(const NTSequence& sequence, double divergence,
+		    double indelRate = 0, int frameShifts = 0);
+
+  /**
+   * Evolve a protein sequence with on average divergence
+   * substitutions per site, and indels at a rate of indelRate per
+   * site.
+   */
+  AASequence evolve(const AASequence& sequence, double divergence,
+		    double indelRate = 0);
+
+  /**
+   * Replace a fraction of the nucleotides by a random ambiguity symbol
+   * that includes the original nucleotide.
+   */
+  void addAmbiguities(NTSequence& sequence, double fraction);
+
+  /**
+   * Generate a sample of n sequences evolved from root (star
+   * phylogeny), all having the length of root (substitutions only).
+   */
+  std::vector<NTSequence> sample(const NTSequence& root, unsigned n,
+				 double divergence);
+
+  /**
+   * A uniform random number in [0, 1[.
+   */
+  double uniform();
+
+  /**
+   * A uniform random integer in [0, n[.
+   */
+  unsigned uniform(unsigned n);
+
+private:
+  Random random_;
+  double rates_[4][4]; // substitution probabilities for divergence 1
+
+  void init(const NucleotideSubstitutionModel& model);
+  Nucleotide substitute(Nucleotide nt, double divergence);
+};
+
+};
+
+#endif // SYNTHETIC_WORKLOAD_H_